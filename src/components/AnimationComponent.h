@@ -0,0 +1,13 @@
+#ifndef DDD_COMPONENTS_ANIMATION_COMPONENT_H
+#define DDD_COMPONENTS_ANIMATION_COMPONENT_H
+
+#include "core/Component.h"
+#include "managers/ResourceHandles.h"
+
+// Plays a shared AnimationLibrary clip on the entity's SpriteComponent.
+struct AnimationComponent : Component {
+    ClipHandle clip{kInvalidHandle};
+    float time{0.0f}; // seconds into the clip; reset to 0 when switching clips
+};
+
+#endif // DDD_COMPONENTS_ANIMATION_COMPONENT_H
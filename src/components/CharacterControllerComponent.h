@@ -0,0 +1,28 @@
+#ifndef DDD_COMPONENTS_CHARACTER_CONTROLLER_COMPONENT_H
+#define DDD_COMPONENTS_CHARACTER_CONTROLLER_COMPONENT_H
+
+#include "core/Component.h"
+#include "utils/Constants.h"
+#include "utils/Vec2.h"
+
+// Kinematic tile-grid mover. CharacterControllerSystem sweeps the AABB against TilemapComponent solidity;
+// the entity's PhysicsBodyComponent (if any) is a kinematic proxy that only pushes dynamic bodies.
+struct CharacterControllerComponent : Component {
+    Vec2 halfExtents{0.4f, 0.8f}; // world units
+    Vec2 velocity{0.0f, 0.0f};    // world units / s, y up
+
+    float moveSpeed{6.0f};
+    float jumpSpeed{8.0f};
+    float maxFallSpeed{30.0f};
+    float stepHeight{10.0f / RENDER_SCALE}; // world units; auto step-up while grounded
+    float coyoteTime{0.1f};  // seconds a jump is still allowed after walking off a ledge
+
+    // Written by PlayerControlSystem each frame; consumed at fixed step.
+    float moveInput{0.0f};
+    bool jumpRequested{false};
+
+    bool grounded{false};
+    float coyoteTimer{0.0f};
+};
+
+#endif // DDD_COMPONENTS_CHARACTER_CONTROLLER_COMPONENT_H
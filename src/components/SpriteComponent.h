@@ -2,6 +2,7 @@
 #define DDD_COMPONENTS_SPRITE_COMPONENT_H
 
 #include "core/Component.h"
+#include "managers/ResourceHandles.h"
 #include "utils/Vec2.h"
 #include <SFML/Graphics.hpp>
 #include <string>
@@ -9,6 +10,9 @@
 struct SpriteComponent : Component {
     std::string textureName;
     std::string atlasRegion;
+    // Interned from the names at spawn (or lazily on first draw); the render path only uses these.
+    TextureHandle texture{kInvalidHandle};
+    RegionHandle region{kInvalidHandle};
     sf::IntRect textureRect{0, 0, 0, 0};
     Vec2 origin{0.0f, 0.0f};
     Vec2 scale{1.0f, 1.0f};
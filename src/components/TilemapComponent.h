@@ -2,6 +2,9 @@
 #define DDD_COMPONENTS_TILEMAP_COMPONENT_H
 
 #include "core/Component.h"
+#include "managers/ResourceHandles.h"
+#include "utils/TileChunkStore.h"
+#include "utils/TileRegistry.h"
 #include "utils/Vec2.h"
 #include <SFML/Graphics.hpp>
 #include <string>
@@ -18,19 +21,30 @@ struct TilemapComponent : Component {
     bool visible{true};
 
     int emptyId{-1};
-    std::vector<int> solidIds;
+    TileRegistry registry; // per-id flags, drops and atlas regions; mirrored into tiles with setSolidity()
 
-    std::vector<int> tiles; // row-major, y grows downward
-    std::vector<int> originalTiles; // snapshot of initial tiles for diff/saving
-    std::unordered_map<int, std::string> tileIdToRegion; // tileId -> atlas region name
+    TileChunkStore tiles; // resident chunks, y grows downward; the rest is streamed by WorldStreamer
     std::string textureName; // optional direct texture if atlas region not used
 
-    int index(int x, int y) const { return y * width + x; }
     bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
-    int get(int x, int y) const { return inBounds(x, y) ? tiles[index(x, y)] : -1; }
-    bool isSolid(int id) const {
-        return std::find(solidIds.begin(), solidIds.end(), id) != solidIds.end();
+    // -1 outside the map or in a chunk that is not resident.
+    int get(int x, int y) const { return inBounds(x, y) ? tiles.get(x, y) : -1; }
+    // Returns false (and changes nothing) outside the map or in a chunk that is not resident.
+    bool set(int x, int y, int tileId) { return inBounds(x, y) && tiles.set(x, y, tileId); }
+    bool isResident(int x, int y) const {
+        return inBounds(x, y) && tiles.find(TileChunkStore::keyForTile(x, y)) != nullptr;
     }
+    // Solidity from the per-chunk row bitsets (kept in sync by tiles.set); false outside the map or streamed out.
+    bool solidAt(int x, int y) const { return inBounds(x, y) && tiles.solidAt(x, y); }
+    // Any solid tile in row y between columns x0 and x1 (inclusive, clamped to the map).
+    bool anySolidInRow(int y, int x0, int x1) const {
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, width - 1);
+        return y >= 0 && y < height && x0 <= x1 && tiles.anySolidInRow(y, x0, x1);
+    }
+    int chunksX() const { return (width + TileChunkStore::kChunkSize - 1) >> TileChunkStore::kChunkShift; }
+    int chunksY() const { return (height + TileChunkStore::kChunkSize - 1) >> TileChunkStore::kChunkShift; }
+    const TileProperties &properties(int tileId) const { return registry[tileId]; }
 };
 
 #endif // DDD_COMPONENTS_TILEMAP_COMPONENT_H
@@ -2,6 +2,7 @@
 #define DDD_CORE_ENTITY_H
 
 #include "Component.h"
+#include <cstdint>
 #include <memory>
 #include <typeindex>
 #include <unordered_map>
@@ -18,6 +19,7 @@ class Entity {
         auto comp = std::make_unique<T>(std::forward<Args>(args)...);
         T *raw = comp.get();
         components[std::type_index(typeid(T))] = std::move(comp);
+        ++structureVersion;
         return raw;
     }
 
@@ -37,15 +39,25 @@ class Entity {
 
     template <typename T> bool has() const { return components.count(std::type_index(typeid(T))) > 0; }
 
-    template <typename T> void remove() { components.erase(std::type_index(typeid(T))); }
+    template <typename T> void remove() {
+        if (components.erase(std::type_index(typeid(T))) != 0)
+            ++structureVersion;
+    }
+
+    // Bumped whenever any entity gains, replaces or loses a component (and by EntityManager on create/remove).
+    static std::uint64_t getStructureVersion() { return structureVersion; }
 
   private:
+    friend class EntityManager;
+
     static Id nextId;
+    static std::uint64_t structureVersion;
     Id id;
     std::unordered_map<std::type_index, std::unique_ptr<Component>> components;
 };
 
 inline Entity::Id Entity::nextId = 0;
+inline std::uint64_t Entity::structureVersion = 0;
 
 #endif // DDD_CORE_ENTITY_H
 
@@ -2,6 +2,8 @@
 #define DDD_CORE_ENTITY_MANAGER_H
 
 #include "Entity.h"
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -11,31 +13,40 @@ class EntityManager {
     Entity &create() {
         auto ent = std::make_unique<Entity>();
         Entity &ref = *ent;
+        byId[ref.getId()] = &ref;
         entities.push_back(std::move(ent));
+        ++Entity::structureVersion;
         return ref;
     }
 
     void remove(Entity::Id id) {
+        if (byId.erase(id) == 0)
+            return;
         auto it = std::remove_if(entities.begin(), entities.end(), [id](const auto &ptr) { return ptr->getId() == id; });
         entities.erase(it, entities.end());
+        ++Entity::structureVersion;
     }
 
     const std::vector<std::unique_ptr<Entity>> &all() const { return entities; }
     std::vector<std::unique_ptr<Entity>> &all() { return entities; }
 
     Entity *find(Entity::Id id) {
-        for (auto &e : entities) {
-            if (e->getId() == id)
-                return e.get();
-        }
-        return nullptr;
+        auto it = byId.find(id);
+        return it != byId.end() ? it->second : nullptr;
     }
 
-    void clear() { entities.clear(); }
+    void clear() {
+        entities.clear();
+        byId.clear();
+        ++Entity::structureVersion;
+    }
+
+    // Changes whenever an entity is created or removed, or any entity gains, replaces or loses a component.
+    std::uint64_t getVersion() const { return Entity::getStructureVersion(); }
 
   private:
     std::vector<std::unique_ptr<Entity>> entities;
+    std::unordered_map<Entity::Id, Entity *> byId; // stable: entities are heap-allocated
 };
 
 #endif // DDD_CORE_ENTITY_MANAGER_H
-
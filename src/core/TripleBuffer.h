@@ -0,0 +1,42 @@
+#ifndef DDD_CORE_TRIPLE_BUFFER_H
+#define DDD_CORE_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Single-producer / single-consumer triple buffer. The producer fills back() and publish()es it;
+// the consumer acquire()s the newest published buffer. Neither side ever waits on the other, and a
+// buffer is never touched by both at once. Unread publishes are overwritten (latest wins), so buffers
+// are reused as-is: callers clear and refill them, keeping their allocations.
+template <typename T> class TripleBuffer {
+  public:
+    T &back() { return buffers[backIndex]; }
+
+    void publish() {
+        // Hand the back buffer over and take whatever sat in the middle slot.
+        const auto fresh = static_cast<std::uint8_t>(backIndex | kFreshBit);
+        const std::uint8_t prev = middle.exchange(fresh, std::memory_order_acq_rel);
+        backIndex = prev & kIndexMask;
+    }
+
+    // Returns the newest published buffer, or nullptr if nothing new arrived since the last call.
+    const T *acquire() {
+        if ((middle.load(std::memory_order_acquire) & kFreshBit) == 0)
+            return nullptr;
+        const std::uint8_t prev = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = prev & kIndexMask;
+        return &buffers[frontIndex];
+    }
+
+  private:
+    static constexpr std::uint8_t kFreshBit = 0x4;
+    static constexpr std::uint8_t kIndexMask = 0x3;
+
+    std::array<T, 3> buffers{};
+    std::uint8_t backIndex{0};              // producer-owned
+    std::uint8_t frontIndex{1};             // consumer-owned
+    std::atomic<std::uint8_t> middle{2};    // shared slot index, kFreshBit set when unread
+};
+
+#endif // DDD_CORE_TRIPLE_BUFFER_H
@@ -2,16 +2,15 @@
 #define DDD_EVENTS_PHYSICS_EVENTS_H
 
 #include "core/Entity.h"
+#include "physics/PhysicsDefs.h"
 
+// Only emitted for pairs someone registered interest in (see PhysicsSystem::watchContactLayer/Tag).
 struct ContactEvent {
     Entity::Id entityA{0};
     Entity::Id entityB{0};
+    CollisionLayer layerA{CollisionLayer::Default};
+    CollisionLayer layerB{CollisionLayer::Default};
     bool isBegin{false};
 };
 
-struct GroundedEvent {
-    Entity::Id entityId{0};
-    bool grounded{false};
-};
-
 #endif // DDD_EVENTS_PHYSICS_EVENTS_H
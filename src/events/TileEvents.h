@@ -2,6 +2,7 @@
 #define DDD_EVENTS_TILE_EVENTS_H
 
 #include "core/Entity.h"
+#include <vector>
 
 struct PlaceBlockEvent {
     int x{0};
@@ -15,5 +16,40 @@ struct BreakBlockEvent {
     int previousTileId{0};
 };
 
+// Every tile edit of one frame, published once after the update systems ran (TileChangeBatchSystem). Cells are
+// coalesced (first previous id, last id); `chunks` has one entry per touched storage chunk
+// (TileChunkStore::kChunkSize tiles) with the inclusive tile bounds of its changed cells, so caches can refresh
+// each chunk once. Place/Break events are still emitted per tile for gameplay listeners.
+struct TileChangedBatch {
+    struct Cell {
+        int x{0};
+        int y{0};
+        int previousTileId{-1};
+        int tileId{-1};
+    };
+    struct ChunkBounds {
+        int chunkX{0};
+        int chunkY{0};
+        int minX{0};
+        int minY{0};
+        int maxX{0};
+        int maxY{0};
+    };
+    std::vector<Cell> cells;
+    std::vector<ChunkBounds> chunks;
+};
+
+// Chunk coordinates are in TileChunkStore::kChunkSize tiles. Emitted by WorldStreamingSystem once the chunk
+// became resident in (or was evicted from) the tilemap; chunks loaded while a map is opened are not announced.
+struct ChunkLoadedEvent {
+    int chunkX{0};
+    int chunkY{0};
+};
+
+struct ChunkUnloadedEvent {
+    int chunkX{0};
+    int chunkY{0};
+};
+
 #endif // DDD_EVENTS_TILE_EVENTS_H
 
@@ -15,25 +15,35 @@
 #include "components/TransformComponent.h"
 #include "components/Tags.h"
 #include "components/PhysicsBodyComponent.h"
+#include "components/CharacterControllerComponent.h"
 #include "components/GroundedComponent.h"
 #include "components/SpriteComponent.h"
 #include "components/DropComponent.h"
+#include "components/AnimationComponent.h"
 #include "utils/CoordinateUtils.h"
+#include "utils/WorldGenerator.h"
 #include <box2d/box2d.h>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <utility>
 
 GameApp::GameApp() {
     loadConfig();
 
+    physicsManager.setCollisionMatrix(config.collisionMatrix);
     windowManager.create(config.windowWidth, config.windowHeight, config.windowTitle);
     cameraManager.setViewportSize({static_cast<float>(config.windowWidth), static_cast<float>(config.windowHeight)});
     resourceManager.setBasePaths(config.resourcesPath, config.texturesPath, config.fontsPath);
+    worldStreamer.setSettings(config.streaming);
 
     // Optional debug font; prefer existing fonts in resources/.
     const std::vector<std::string> debugFontCandidates = {"ArialRegular.ttf", "RobotoMono-VariableFont_wght.ttf", "debug.ttf"};
@@ -86,6 +96,12 @@ void GameApp::loadConfig() {
                 config.tileSize = w["tile_size"].get<float>() / RENDER_SCALE;
             if (w.contains("map_file"))
                 config.mapFile = w["map_file"].get<std::string>();
+            if (w.contains("streaming")) {
+                const auto &st = w["streaming"];
+                config.streaming.enabled = st.value("enabled", config.streaming.enabled);
+                config.streaming.radiusChunks = std::max(1, st.value("radius_chunks", config.streaming.radiusChunks));
+                config.streaming.cacheDir = st.value("cache_dir", config.streaming.cacheDir);
+            }
         }
         if (j.contains("inventory_file"))
             config.inventoryFile = j["inventory_file"].get<std::string>();
@@ -97,6 +113,58 @@ void GameApp::loadConfig() {
                 config.playerJump = p["jump_impulse"].get<float>();
             if (p.contains("pickup_radius"))
                 config.pickupRadius = p["pickup_radius"].get<float>() / RENDER_SCALE;
+            if (p.contains("step_height"))
+                config.playerStepHeight = p["step_height"].get<float>() / RENDER_SCALE;
+            if (p.contains("coyote_time"))
+                config.playerCoyoteTime = p["coyote_time"].get<float>();
+        }
+        if (j.contains("render")) {
+            const auto &r = j["render"];
+            const std::string mode = r.value("tilemap_mode", std::string{"chunks"});
+            if (mode == "shader")
+                config.tilemapMode = TilemapRenderMode::Shader;
+            else if (mode == "chunks")
+                config.tilemapMode = TilemapRenderMode::Chunks;
+            else
+                std::cerr << "Unknown render.tilemap_mode in config: " << mode << "\n";
+            config.renderThreaded = r.value("threaded", config.renderThreaded);
+            config.minimapEnabled = r.value("minimap", config.minimapEnabled);
+        }
+        if (j.contains("atlas")) {
+            const auto &a = j["atlas"];
+            config.atlasEnabled = a.value("enabled", config.atlasEnabled);
+            config.atlas.maxPageSize = a.value("max_page_size", config.atlas.maxPageSize);
+            config.atlas.padding = std::max(0, a.value("padding", config.atlas.padding));
+            config.atlas.cacheDir = a.value("cache_dir", config.atlas.cacheDir);
+        }
+        if (j.contains("physics")) {
+            const auto &ph = j["physics"];
+            config.maxPhysicsSteps = std::max(1, ph.value("max_steps_per_frame", config.maxPhysicsSteps));
+            config.physicsBudgetMs = ph.value("step_budget_ms", config.physicsBudgetMs);
+            config.adaptiveIterations = ph.value("adaptive_iterations", config.adaptiveIterations);
+            // Pairs listed here collide (symmetric); any pair not listed is filtered out by Box2D.
+            if (ph.contains("collision_matrix") && ph["collision_matrix"].is_object()) {
+                config.collisionMatrix.setAll(false);
+                for (auto &[layerName, others] : ph["collision_matrix"].items()) {
+                    const auto layer = CollisionMatrix::parseLayer(layerName);
+                    if (!layer || !others.is_array()) {
+                        std::cerr << "Unknown collision layer in config: " << layerName << "\n";
+                        continue;
+                    }
+                    for (const auto &other : others) {
+                        if (!other.is_string()) {
+                            std::cerr << "Ignoring non-string collision layer for " << layerName << ": " << other
+                                      << "\n";
+                            continue;
+                        }
+                        const auto otherLayer = CollisionMatrix::parseLayer(other.get<std::string>());
+                        if (otherLayer)
+                            config.collisionMatrix.setCollides(*layer, *otherLayer, true);
+                        else
+                            std::cerr << "Unknown collision layer in config: " << other << "\n";
+                    }
+                }
+            }
         }
     } catch (const std::exception &e) {
         std::cerr << "Failed to parse config/game.json: " << e.what() << "\n";
@@ -114,26 +182,51 @@ void GameApp::loadResources() {
         chosenTexture = &tilesPath;
     }
 
-    if (chosenTexture) {
-        try {
-            resourceManager.loadTexture("tiles", *chosenTexture);
-            const int tilePx = 32;
-            const std::pair<std::string, std::pair<int, int>> regions[] = {
-                {"ground", {0, 0}},       {"path", {1, 0}},      {"grass_alt", {6, 0}},   {"grass_dark", {7, 0}},
-                {"water", {10, 0}},       {"stone_brick", {11, 0}}, {"dirt", {12, 0}}, {"roof", {13, 0}},
-                {"trunk", {1, 1}},        {"leaves", {6, 1}},
-            };
-            for (const auto &r : regions) {
-                const auto [name, pos] = r;
-                const int x = pos.first * tilePx;
-                const int y = pos.second * tilePx;
-                resourceManager.registerAtlasRegion(name, "tiles", sf::IntRect{x, y, tilePx, tilePx});
-            }
-        } catch (const std::exception &e) {
-            std::cerr << "Resource load failed: " << e.what() << "\n";
+    // Every other PNG in the textures dir is available under its file stem (player, orc, bat, ...).
+    std::vector<ResourceManager::AtlasSource> sources;
+    if (chosenTexture)
+        sources.push_back({"tiles", *chosenTexture});
+    const std::filesystem::path texturesDir = resourceManager.resolveTexturePath("");
+    std::error_code dirError;
+    for (const auto &entry : std::filesystem::directory_iterator(texturesDir, dirError)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".png")
+            continue;
+        const std::filesystem::path file = entry.path().filename();
+        if (file == "tileMap.png" || file == "tiles.png")
+            continue;
+        sources.push_back({entry.path().stem().string(), entry.path().string()});
+    }
+    std::sort(sources.begin(), sources.end(), [](const auto &a, const auto &b) { return a.name < b.name; });
+
+    try {
+        if (config.atlasEnabled) {
+            resourceManager.packAtlas("atlas", sources, config.atlas);
+        } else {
+            for (const auto &src : sources)
+                resourceManager.loadTexture(src.name, src.path);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Resource load failed: " << e.what() << "\n";
+    }
+
+    // Region rects are relative to tileMap.png; ResourceManager remaps them if it was packed.
+    if (resourceManager.hasTexture("tiles")) {
+        const int tilePx = 32;
+        const std::pair<std::string, std::pair<int, int>> regions[] = {
+            {"ground", {0, 0}},       {"path", {1, 0}},      {"grass_alt", {6, 0}},   {"grass_dark", {7, 0}},
+            {"water", {10, 0}},       {"stone_brick", {11, 0}}, {"dirt", {12, 0}}, {"roof", {13, 0}},
+            {"trunk", {1, 1}},        {"leaves", {6, 1}},
+        };
+        for (const auto &r : regions) {
+            const auto [name, pos] = r;
+            const int x = pos.first * tilePx;
+            const int y = pos.second * tilePx;
+            resourceManager.registerAtlasRegion(name, "tiles", sf::IntRect{x, y, tilePx, tilePx});
         }
     }
 
+    animationLibrary.loadFromFile("config/animations.json", resourceManager);
+
     // Load a visible debug font from available assets.
     const std::string arialPath = resourceManager.resolveFontPath("ArialRegular.ttf");
     const std::string robotoPath = resourceManager.resolveFontPath("RobotoMono-VariableFont_wght.ttf");
@@ -165,30 +258,47 @@ void GameApp::initSystems() {
     inventoryPtr->loadConfigFromFile(inventoryPath.string());
     inventorySystem = inventoryPtr.get();
 
-    physicsSystem = std::make_unique<PhysicsSystem>(physicsManager, entityManager, eventBus);
+    physicsSystem = std::make_unique<PhysicsSystem>(physicsManager, entityManager, eventBus, spatialIndex);
+    physicsSystem->setDropRegionLookup(
+        [this](const TilemapComponent &map, int itemId) { return dropRegion(map, itemId); });
+    characterControllerSystem = std::make_unique<CharacterControllerSystem>(entityManager, physicsManager);
 
     updateSystems.push_back(std::move(inputPtr));
     updateSystems.push_back(std::move(inventoryPtr));
-    updateSystems.push_back(
-        std::make_unique<DropPickupSystem>(entityManager, *inventorySystem, physicsManager, config.pickupRadius));
-    updateSystems.push_back(std::make_unique<PlayerControlSystem>(*inputSystem, entityManager, eventBus, config.playerSpeed,
-                                                                  config.playerJump));
+    updateSystems.push_back(std::make_unique<DropPickupSystem>(entityManager, *inventorySystem, physicsManager,
+                                                               spatialIndex, config.pickupRadius));
+    updateSystems.push_back(std::make_unique<PlayerControlSystem>(*inputSystem, entityManager));
     updateSystems.push_back(std::make_unique<CameraFollowSystem>(cameraManager, entityManager));
+    updateSystems.push_back(
+        std::make_unique<WorldStreamingSystem>(worldStreamer, cameraManager, entityManager, eventBus));
     updateSystems.push_back(std::make_unique<TileInteractionSystem>(*inputSystem, entityManager, eventBus, inventorySystem));
     updateSystems.push_back(std::make_unique<DebugSystem>(entityManager, debugManager, *inputSystem));
-
-    renderSystems.push_back(std::make_unique<RenderSystem>(windowManager, cameraManager, resourceManager, entityManager));
+    updateSystems.push_back(std::make_unique<AnimationSystem>(entityManager, animationLibrary));
+    auto particlePtr = std::make_unique<ParticleSystem>(entityManager, eventBus);
+    particleSystem = particlePtr.get();
+    updateSystems.push_back(std::move(particlePtr));
+    // Last: publishes the tile edits made by the systems above.
+    updateSystems.push_back(std::make_unique<TileChangeBatchSystem>(entityManager, eventBus));
+
+    auto renderPtr = std::make_unique<RenderSystem>(windowManager, cameraManager, resourceManager, entityManager,
+                                                    eventBus, spatialIndex);
+    renderPtr->setTilemapMode(config.tilemapMode);
+    renderPtr->setMinimapEnabled(config.minimapEnabled);
+    renderSystem = renderPtr.get();
+    renderSystems.push_back(std::move(renderPtr));
     auto uiPtr = std::make_unique<UIRenderSystem>(windowManager, resourceManager, debugManager, eventBus);
     uiRenderSystem = uiPtr.get();
     uiRenderSystem->setMenuState(&menuRenderState);
+    uiRenderSystem->setMinimap(config.minimapEnabled ? &renderSystem->getMinimap() : nullptr);
     renderSystems.push_back(std::move(uiPtr));
 }
 
 void GameApp::run() {
     sf::RenderWindow &window = windowManager.getWindow();
 
-    float physicsAccumulator = 0.0f;
     bool running = true;
+    if (config.renderThreaded)
+        startRenderThread();
 
     while (running && window.isOpen()) {
         if (inputSystem)
@@ -203,7 +313,6 @@ void GameApp::run() {
         }
 
         const float dt = timeManager.tick();
-        physicsAccumulator += dt;
 
         if (inputSystem)
             inputSystem->update(dt);
@@ -218,25 +327,170 @@ void GameApp::run() {
             sys->update(dt);
         }
 
-        if (physicsSystem) {
-        while (physicsAccumulator >= PHYSICS_TIMESTEP) {
-                physicsSystem->update(PHYSICS_TIMESTEP);
-            physicsAccumulator -= PHYSICS_TIMESTEP;
-        }
-        } else {
-            physicsAccumulator = 0.0f;
-        }
+        stepPhysics(dt);
 
         eventBus.pump();
 
-        for (auto &sys : renderSystems)
-            sys->update(dt);
+        submitFrame(dt);
     }
 
+    stopRenderThread();
     if (window.isOpen())
         window.close();
 }
 
+void GameApp::submitFrame(float dt) {
+    RenderSnapshot &snapshot = snapshots.back();
+    renderSystem->extract(snapshot);
+    particleSystem->extract(snapshot.particles);
+    uiRenderSystem->extract(snapshot.ui, dt);
+
+    if (!renderThread.joinable()) {
+        renderFrame(snapshot);
+        return;
+    }
+
+    snapshots.publish();
+    std::unique_lock<std::mutex> lock(frameMutex);
+    publishedFrame = snapshot.frame;
+    frameCv.notify_all();
+    // Keep at most one frame in flight: simulating frame N+1 overlaps rendering frame N, never N-1.
+    frameCv.wait(lock, [&] { return presentedFrame + 1 >= publishedFrame || stopRendering; });
+}
+
+void GameApp::renderFrame(const RenderSnapshot &snapshot) {
+    sf::RenderWindow &window = windowManager.getWindow();
+    renderSystem->render(snapshot, window);
+    uiRenderSystem->render(snapshot.ui, window);
+    window.display();
+}
+
+void GameApp::startRenderThread() {
+    if (renderThread.joinable())
+        return;
+    stopRendering = false;
+    // A GL context can be current on one thread only; hand the window's over to the render thread.
+    windowManager.getWindow().setActive(false);
+    renderThread = std::thread(&GameApp::renderLoop, this);
+}
+
+void GameApp::stopRenderThread() {
+    if (!renderThread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        stopRendering = true;
+    }
+    frameCv.notify_all();
+    renderThread.join();
+    windowManager.getWindow().setActive(true);
+}
+
+void GameApp::renderLoop() {
+    sf::RenderWindow &window = windowManager.getWindow();
+    window.setActive(true);
+
+    std::uint64_t lastFrame = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(frameMutex);
+            frameCv.wait(lock, [&] { return stopRendering || publishedFrame > lastFrame; });
+            if (stopRendering)
+                break;
+        }
+        // Latest wins: frames published while the previous one was on screen are skipped.
+        const RenderSnapshot *snapshot = snapshots.acquire();
+        if (!snapshot)
+            continue;
+        renderFrame(*snapshot);
+        lastFrame = snapshot->frame;
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            presentedFrame = lastFrame;
+        }
+        frameCv.notify_all();
+    }
+
+    window.setActive(false);
+}
+
+void GameApp::stepPhysics(float dt) {
+    if (!physicsSystem) {
+        physicsAccumulator = 0.0f;
+        return;
+    }
+
+    physicsAccumulator += dt;
+
+    // Steady clock: monotonic, nanosecond resolution on our targets.
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const auto budget = std::chrono::duration<float, std::milli>(config.physicsBudgetMs);
+
+    PhysicsStepStats &stats = physicsStepStats;
+    stats.steps = 0;
+    stats.droppedSteps = 0;
+    stats.overBudget = false;
+    while (physicsAccumulator >= PHYSICS_TIMESTEP && stats.steps < config.maxPhysicsSteps) {
+        if (characterControllerSystem)
+            characterControllerSystem->update(PHYSICS_TIMESTEP);
+        physicsSystem->update(PHYSICS_TIMESTEP);
+        physicsAccumulator -= PHYSICS_TIMESTEP;
+        ++stats.steps;
+        if (Clock::now() - start > budget) {
+            stats.overBudget = true;
+            break;
+        }
+    }
+    stats.elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+    // Spiral-of-death guard: whatever could not be simulated this frame is dropped (the world slows down
+    // instead of queuing ever more steps for the next, already late, frame).
+    if (physicsAccumulator >= PHYSICS_TIMESTEP) {
+        stats.droppedSteps = static_cast<int>(physicsAccumulator / PHYSICS_TIMESTEP);
+        stats.droppedTotal += stats.droppedSteps;
+        physicsAccumulator -= static_cast<float>(stats.droppedSteps) * PHYSICS_TIMESTEP;
+    }
+
+    if (config.adaptiveIterations)
+        adaptSolverIterations();
+    publishPhysicsStepStats();
+}
+
+void GameApp::adaptSolverIterations() {
+    const PhysicsStepStats &stats = physicsStepStats;
+    int vel = physicsSystem->getVelocityIterations();
+    int pos = physicsSystem->getPositionIterations();
+
+    if (stats.overBudget || stats.droppedSteps > 0) {
+        // Degrade fast under load...
+        vel = std::max(PHYSICS_MIN_VELOCITY_ITER, vel / 2);
+        pos = std::max(PHYSICS_MIN_POSITION_ITER, pos - 1);
+    } else if (stats.steps > 0 && stats.elapsedMs < config.physicsBudgetMs * 0.5f) {
+        // ...recover slowly once there is headroom again.
+        vel = std::min(PHYSICS_VELOCITY_ITER, vel + 1);
+        if (vel == PHYSICS_VELOCITY_ITER)
+            pos = std::min(PHYSICS_POSITION_ITER, pos + 1);
+    }
+    physicsSystem->setSolverIterations(vel, pos);
+}
+
+void GameApp::publishPhysicsStepStats() {
+    const PhysicsStepStats &stats = physicsStepStats;
+    std::ostringstream timing;
+    timing.setf(std::ios::fixed);
+    timing << std::setprecision(2) << "time: " << stats.elapsedMs << " ms (budget " << config.physicsBudgetMs
+           << ")" << (stats.overBudget ? " OVER" : "");
+    debugManager.setSection("physics_step",
+                            {"steps: " + std::to_string(stats.steps) + "/" + std::to_string(config.maxPhysicsSteps),
+                             timing.str(),
+                             "iters: vel " + std::to_string(physicsSystem->getVelocityIterations()) + " pos " +
+                                 std::to_string(physicsSystem->getPositionIterations()),
+                             "dropped: " + std::to_string(stats.droppedSteps) + " (total " +
+                                 std::to_string(stats.droppedTotal) + ")",
+                             "parked bodies: " + std::to_string(physicsSystem->getParkedBodyCount())});
+}
+
 void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
     nlohmann::json j;
     bool loaded = false;
@@ -258,11 +512,12 @@ void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
     int height = 12;
     float tileSize = config.tileSize;
     int emptyId = -1;
-    std::vector<int> tiles;
     std::unordered_map<int, std::string> idToRegion;
     std::vector<int> solidIds{1};
+    nlohmann::json tileProperties; // per-id overrides: solid, opaque, liquid, breakable, hardness, drop, light
     Vec2 origin{0.0f, 0.0f};
     Vec2 playerSpawn{1.5f, 2.0f};
+    std::optional<WorldGenerator> generator; // maps with a "generator" block are generated instead of read
 
     if (loaded) {
         width = j.value("width", width);
@@ -288,7 +543,81 @@ void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
                 idToRegion[std::stoi(k)] = v.get<std::string>();
             }
         }
+        if (j.contains("tile_properties") && j["tile_properties"].is_object())
+            tileProperties = j["tile_properties"];
+        if (j.contains("generator") && j["generator"].is_object()) {
+            const auto &g = j["generator"];
+            WorldGenerator::Settings gen;
+            gen.seed = g.value("seed", gen.seed);
+            gen.width = width;
+            gen.height = height;
+            gen.surfaceLevel = g.value("surface_level", gen.surfaceLevel);
+            gen.hillHeight = g.value("hill_height", gen.hillHeight);
+            gen.waterLevel = g.value("water_level", gen.waterLevel);
+            gen.caveDensity = g.value("cave_density", gen.caveDensity);
+            gen.oreDensity = g.value("ore_density", gen.oreDensity);
+            gen.treeChance = g.value("tree_chance", gen.treeChance);
+            gen.houseChance = g.value("house_chance", gen.houseChance);
+            gen.threads = g.value("threads", gen.threads);
+
+            // Materials are picked by region name ("regions" overrides the defaults) and resolved to the
+            // smallest tile id mapped to that region.
+            const nlohmann::json regions = g.value("regions", nlohmann::json::object());
+            const auto tileFor = [&](const std::string &material, const std::string &defaultRegion) {
+                const std::string region = regions.value(material, defaultRegion);
+                int found = emptyId;
+                for (const auto &[id, name] : idToRegion) {
+                    if (name == region && (found == emptyId || id < found))
+                        found = id;
+                }
+                if (found == emptyId)
+                    std::cerr << "Generator region '" << region << "' is not in tile_id_to_region\n";
+                return found;
+            };
+            WorldGenerator::Tiles materials;
+            materials.empty = emptyId;
+            materials.grass = tileFor("grass", "ground");
+            materials.dirt = tileFor("dirt", "dirt");
+            materials.stone = tileFor("stone", "stone_brick");
+            materials.ore = tileFor("ore", "path");
+            materials.trunk = tileFor("trunk", "trunk");
+            materials.leaves = tileFor("leaves", "leaves");
+            materials.water = tileFor("water", "water");
+            materials.roof = tileFor("roof", "roof");
+            materials.wall = tileFor("wall", "stone_brick");
+            generator.emplace(gen, materials);
+
+            if (!j.contains("player_spawn")) {
+                int spawnX = 0;
+                int spawnY = 0;
+                generator->spawnTile(spawnX, spawnY);
+                playerSpawn = Vec2{origin.x + (static_cast<float>(spawnX) + 0.5f) * tileSize,
+                                   origin.y - (static_cast<float>(spawnY) + 0.5f) * tileSize};
+            }
+        }
+    }
 
+    // Tiles are streamed from region files under the world cache; the map is only converted when it changed.
+    std::string worldName = "default";
+    std::string stamp = "default";
+    if (loaded) {
+        std::error_code ec;
+        worldName = mapPath.stem().string();
+        stamp = mapPath.generic_string() + ":" +
+                std::to_string(std::filesystem::last_write_time(mapPath, ec).time_since_epoch().count());
+    }
+    stamp += ":" + std::to_string(width) + "x" + std::to_string(height) + ":" + std::to_string(emptyId);
+    if (generator)
+        stamp += ":gen" + std::to_string(WorldGenerator::kVersion);
+    const int chunksX = (width + TileChunkStore::kChunkSize - 1) / TileChunkStore::kChunkSize;
+    const int chunksY = (height + TileChunkStore::kChunkSize - 1) / TileChunkStore::kChunkSize;
+    const bool cached = worldStreamer.open(worldName, stamp, chunksX, chunksY, emptyId);
+    if (!cached && generator) {
+        worldStreamer.writeBase(stamp, [&](int cx0, int cy0, int cx1, int cy1, std::vector<std::vector<int>> &chunks) {
+            generator->generateChunks(cx0, cy0, cx1, cy1, chunks);
+        });
+    } else if (!cached) {
+        std::vector<int> tiles;
         const auto readTilesFlat = [&]() {
             if (!j.contains("tiles"))
                 return false;
@@ -308,21 +637,22 @@ void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
             return true;
         };
 
-        if (!readTilesFlat()) {
+        if (!loaded) {
+            tiles.assign(width * height, emptyId);
+            // Simple ground layer on the bottom row.
+            const int groundY = height - 1;
+            for (int x = 0; x < width; ++x) {
+                tiles[groundY * width + x] = 1;
+            }
+        } else if (!readTilesFlat()) {
             tiles.assign(width * height, emptyId);
         }
-    } else {
-        tiles.assign(width * height, emptyId);
-        // Simple ground layer on the bottom row.
-        const int groundY = height - 1;
-        for (int x = 0; x < width; ++x) {
-            tiles[groundY * width + x] = 1;
-        }
-    }
 
-    // Ensure tile buffer size.
-    if (static_cast<int>(tiles.size()) < width * height)
-        tiles.resize(width * height, emptyId);
+        // Ensure tile buffer size.
+        if (static_cast<int>(tiles.size()) < width * height)
+            tiles.resize(width * height, emptyId);
+        worldStreamer.writeBase(tiles, width, height, stamp);
+    }
 
     Entity &tileEnt = entityManager.create();
     auto *tileTransform = tileEnt.addComponent<TransformComponent>();
@@ -334,18 +664,51 @@ void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
     tilemap->tileSize = tileSize;
     tilemap->origin = origin;
     tilemap->emptyId = emptyId;
-    tilemap->solidIds = solidIds;
-    tilemap->tiles = std::move(tiles);
-    tilemap->originalTiles = tilemap->tiles;
-    tilemap->tileIdToRegion = std::move(idToRegion);
+
+    // Tile registry: configured ids are breakable and drop themselves; solid ones are opaque too.
+    TileRegistry &registry = tilemap->registry;
+    for (const auto &[tileId, region] : idToRegion) {
+        if (tileId >= 0)
+            registry.setRegionName(tileId, region);
+    }
+    for (int tileId : solidIds) {
+        if (tileId >= 0)
+            registry.define(tileId).flags |= TileProperties::Solid | TileProperties::Opaque;
+    }
+    for (auto &[key, value] : tileProperties.items()) {
+        const int tileId = std::stoi(key);
+        if (tileId < 0 || !value.is_object()) {
+            std::cerr << "Ignoring tile_properties entry '" << key << "'\n";
+            continue;
+        }
+        TileProperties &props = registry.define(tileId);
+        const auto flag = [&](const char *name, TileProperties::Flag bit) {
+            if (value.contains(name))
+                props.flags = value[name].get<bool>() ? (props.flags | bit) : (props.flags & ~bit);
+        };
+        flag("solid", TileProperties::Solid);
+        flag("opaque", TileProperties::Opaque);
+        flag("liquid", TileProperties::Liquid);
+        flag("breakable", TileProperties::Breakable);
+        props.hardness = value.value("hardness", props.hardness);
+        props.dropItem = value.value("drop", props.dropItem);
+        const int light = value.value("light", static_cast<int>(props.light));
+        props.light = static_cast<std::uint8_t>(std::clamp(light, 0, 255));
+    }
+    registry.defineEmpty(emptyId);
+    tilemap->tiles.setSolidity(registry);
+    loadChunksAround(*tilemap, playerSpawn);
 
     // Register atlas regions on demand if missing, using default rect derived from tile size.
     const int defaultTilePx = static_cast<int>(tileSize * RENDER_SCALE);
-    for (const auto &kv : tilemap->tileIdToRegion) {
-        const std::string &region = kv.second;
+    for (int tileId = 0; tileId < registry.size(); ++tileId) {
+        const std::string &region = registry.regionName(tileId);
+        if (region.empty())
+            continue;
         if (!resourceManager.hasAtlasRegion(region) && resourceManager.hasTexture("tiles")) {
             resourceManager.registerAtlasRegion(region, "tiles", sf::IntRect{0, 0, defaultTilePx, defaultTilePx});
         }
+        registry.setRegion(tileId, resourceManager.regionHandle(region));
     }
 
     Entity &player = entityManager.create();
@@ -355,25 +718,48 @@ void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
     auto *pTransform = player.addComponent<TransformComponent>();
     pTransform->position = playerSpawn;
 
+    const Vec2 playerSize{tileSize * 0.8f, tileSize * 1.6f};
+    auto *controller = player.addComponent<CharacterControllerComponent>();
+    controller->halfExtents = playerSize * 0.5f;
+    controller->moveSpeed = config.playerSpeed;
+    controller->jumpSpeed = config.playerJump;
+    controller->stepHeight = config.playerStepHeight;
+    controller->coyoteTime = config.playerCoyoteTime;
+
+    // Kinematic proxy: tiles are resolved by the controller, the body only pushes drops and other dynamics.
     auto *body = player.addComponent<PhysicsBodyComponent>();
-    body->bodyType = b2_dynamicBody;
+    body->bodyType = b2_kinematicBody;
     body->position = playerSpawn;
     body->fixture.shape = PhysicsShapeType::Box;
-    body->fixture.size = Vec2{tileSize * 0.8f, tileSize * 1.6f};
+    body->fixture.size = playerSize;
     body->fixture.density = 1.0f;
     body->fixture.friction = 0.2f;
     body->fixture.restitution = 0.0f;
     body->fixture.canRotate = false;
-    body->fixture.isFootSensor = true; // use main fixture to detect grounded for now
+    body->fixture.layer = CollisionLayer::Player;
 
-    // Temporary player sprite using tiles texture; scaled to collider size.
     auto *sprite = player.addComponent<SpriteComponent>();
-    sprite->textureName = "tiles";
-    sprite->useTextureRect = true;
-    sprite->textureRect = sf::IntRect{0, 0, 32, 32};
-    sprite->origin = Vec2{16.0f, 16.0f};
-    sprite->scale = Vec2{0.8f, 1.6f}; // world 0.8x1.6 assuming 32px tile
     sprite->z = 0;
+    const ClipHandle idleClip = animationLibrary.handle("player_idle");
+    if (const AnimationLibrary::Clip *clip = animationLibrary.clip(idleClip)) {
+        // Animated sprite scaled from its first frame to the collider size.
+        const sf::IntRect &frame = clip->frames.front();
+        sprite->texture = clip->texture;
+        sprite->useTextureRect = true;
+        sprite->textureRect = frame;
+        sprite->origin = Vec2{frame.width * 0.5f, frame.height * 0.5f};
+        sprite->scale = Vec2{playerSize.x * RENDER_SCALE / static_cast<float>(frame.width),
+                             playerSize.y * RENDER_SCALE / static_cast<float>(frame.height)};
+        player.addComponent<AnimationComponent>()->clip = idleClip;
+    } else {
+        // Fallback player sprite using tiles texture; scaled to collider size.
+        sprite->textureName = "tiles";
+        sprite->texture = resourceManager.textureHandle(sprite->textureName);
+        sprite->useTextureRect = true;
+        sprite->textureRect = sf::IntRect{0, 0, 32, 32};
+        sprite->origin = Vec2{16.0f, 16.0f};
+        sprite->scale = Vec2{0.8f, 1.6f}; // world 0.8x1.6 assuming 32px tile
+    }
 
     if (inventorySystem)
         inventorySystem->attachToEntity(player);
@@ -382,6 +768,19 @@ void GameApp::loadMapAndEntities(const std::filesystem::path &mapPath) {
     cameraManager.setCenter(playerSpawn);
 }
 
+void GameApp::loadChunksAround(TilemapComponent &tilemap, const Vec2 &worldPos) {
+    if (!config.streaming.enabled) {
+        worldStreamer.loadAll(tilemap.tiles);
+        return;
+    }
+    // Synchronous, so the first frames (and physics) already see the ground; the rest streams in.
+    const float chunkWorld = tilemap.tileSize * TileChunkStore::kChunkSize;
+    const int cx = static_cast<int>(std::floor((worldPos.x - tilemap.origin.x) / chunkWorld));
+    const int cy = static_cast<int>(std::floor((tilemap.origin.y - worldPos.y) / chunkWorld));
+    const int r = config.streaming.radiusChunks;
+    worldStreamer.loadNow(tilemap.tiles, cx - r, cy - r, cx + r, cy + r);
+}
+
 void GameApp::refreshMapList() {
     mapFiles.clear();
     const std::filesystem::path mapsDir = std::filesystem::path("config") / "maps";
@@ -601,6 +1000,7 @@ void GameApp::handleMenuClicks() {
         if (btn.id == "play") {
             setMenuVisible(AppScreen::MapSelect);
         } else if (btn.id == "exit") {
+            stopRenderThread();
             windowManager.getWindow().close();
         } else if (btn.id == "continue") {
             if (!loadSave(std::filesystem::path("saves") / "latest.json"))
@@ -757,27 +1157,16 @@ std::optional<GameApp::SaveData> GameApp::collectSaveData() {
     if (!tilemap || !player)
         return std::nullopt;
 
-    const int w = tilemap->width;
-    const int h = tilemap->height;
-    if (!tilemap->originalTiles.empty()) {
-        for (int y = 0; y < h; ++y) {
-            for (int x = 0; x < w; ++x) {
-                const int idx = tilemap->index(x, y);
-                if (idx < 0 || idx >= static_cast<int>(tilemap->tiles.size()) ||
-                    idx >= static_cast<int>(tilemap->originalTiles.size()))
-                    continue;
-                const int base = tilemap->originalTiles[idx];
-                const int cur = tilemap->tiles[idx];
-                if (cur == base)
-                    continue;
-                if (cur == tilemap->emptyId) {
-                    data.removed.push_back({x, y, cur});
-                } else {
-                    data.placed.push_back({x, y, cur});
-                }
-            }
+    // Edits are journaled as they happen, so only edited cells are visited (resident or streamed out).
+    tilemap->tiles.journal().forEachChange([&](const TileJournal::Entry &e) {
+        if (!tilemap->inBounds(e.x, e.y))
+            return;
+        if (e.after == tilemap->emptyId) {
+            data.removed.push_back({e.x, e.y, e.after});
+        } else {
+            data.placed.push_back({e.x, e.y, e.after});
         }
-    }
+    });
 
     for (auto &entPtr : entityManager.all()) {
         auto *drop = entPtr->get<DropComponent>();
@@ -802,7 +1191,10 @@ std::optional<GameApp::SaveData> GameApp::collectSaveData() {
         data.player.px = t->position.x;
         data.player.py = t->position.y;
     }
-    if (auto *body = player->get<PhysicsBodyComponent>(); body && body->body) {
+    if (auto *ctrl = player->get<CharacterControllerComponent>()) {
+        data.player.vx = ctrl->velocity.x;
+        data.player.vy = ctrl->velocity.y;
+    } else if (auto *body = player->get<PhysicsBodyComponent>(); body && body->body) {
         const b2Vec2 vel = body->body->GetLinearVelocity();
         const Vec2 wv = physicsToWorld(Vec2{vel.x, vel.y});
         data.player.vx = wv.x;
@@ -900,18 +1292,29 @@ bool GameApp::applySaveData(const SaveData &data) {
     if (!tilemap || !player)
         return false;
 
-    for (const auto &t : data.removed) {
-        if (tilemap->inBounds(t.x, t.y))
-            tilemap->tiles[tilemap->index(t.x, t.y)] = tilemap->emptyId;
-    }
-    for (const auto &t : data.placed) {
-        if (tilemap->inBounds(t.x, t.y))
-            tilemap->tiles[tilemap->index(t.x, t.y)] = t.tileId;
-    }
+    // Edited chunks may lie outside the area loaded around the spawn; they are loaded on demand.
+    const auto writeTile = [&](int x, int y, int tileId) {
+        if (!tilemap->inBounds(x, y))
+            return;
+        const int cx = TileChunkStore::chunkCoord(x);
+        const int cy = TileChunkStore::chunkCoord(y);
+        worldStreamer.loadNow(tilemap->tiles, cx, cy, cx, cy);
+        tilemap->set(x, y, tileId);
+    };
+    for (const auto &t : data.removed)
+        writeTile(t.x, t.y, tilemap->emptyId);
+    for (const auto &t : data.placed)
+        writeTile(t.x, t.y, t.tileId);
+    loadChunksAround(*tilemap, Vec2{data.player.px, data.player.py});
 
     if (auto *t = player->get<TransformComponent>()) {
         t->position = Vec2{data.player.px, data.player.py};
     }
+    if (auto *ctrl = player->get<CharacterControllerComponent>()) {
+        ctrl->velocity = Vec2{data.player.vx, data.player.vy};
+    }
+    if (auto *body = player->get<PhysicsBodyComponent>())
+        body->position = Vec2{data.player.px, data.player.py};
     if (auto *body = player->get<PhysicsBodyComponent>(); body && body->body) {
         const Vec2 pv = worldToPhysics(Vec2{data.player.vx, data.player.vy});
         body->body->SetLinearVelocity(b2Vec2{pv.x, pv.y});
@@ -944,6 +1347,7 @@ bool GameApp::applySaveData(const SaveData &data) {
         body->fixture.angularDamping = 1.0f;
         body->fixture.canRotate = true;
         body->fixture.isSensor = false;
+        body->fixture.layer = CollisionLayer::Drop;
 
         auto *dropComp = dropEnt.addComponent<DropComponent>();
         dropComp->itemId = d.itemId;
@@ -951,6 +1355,7 @@ bool GameApp::applySaveData(const SaveData &data) {
 
         auto *sprite = dropEnt.addComponent<SpriteComponent>();
         sprite->textureName = "tiles";
+        sprite->texture = resourceManager.textureHandle(sprite->textureName);
         sprite->useTextureRect = true;
         sprite->textureRect = sf::IntRect{0, 0, 32, 32};
         sprite->origin = Vec2{16.0f, 16.0f};
@@ -958,9 +1363,8 @@ bool GameApp::applySaveData(const SaveData &data) {
         sprite->scale = Vec2{dropScale, dropScale};
 
         if (tilemap) {
-            auto itRegion = tilemap->tileIdToRegion.find(dropComp->itemId);
-            if (itRegion != tilemap->tileIdToRegion.end()) {
-                sprite->atlasRegion = itRegion->second;
+            if (const RegionHandle region = dropRegion(*tilemap, dropComp->itemId); region != kInvalidHandle) {
+                sprite->region = region;
                 sprite->useTextureRect = false;
             }
         }
@@ -969,3 +1373,18 @@ bool GameApp::applySaveData(const SaveData &data) {
     return true;
 }
 
+// Drops show the item's icon; items without one show the tile they place. Ids missing from the inventory config
+// place the tile of the same id, as InventorySystem assumes for them.
+RegionHandle GameApp::dropRegion(const TilemapComponent &map, int itemId) {
+    int placeTileId = itemId;
+    if (inventorySystem) {
+        const auto &defs = inventorySystem->getDefinitions();
+        if (auto it = defs.find(itemId); it != defs.end()) {
+            if (resourceManager.hasAtlasRegion(it->second.iconRegion))
+                return resourceManager.regionHandle(it->second.iconRegion);
+            placeTileId = it->second.placeTileId;
+        }
+    }
+    return placeTileId >= 0 ? map.registry.region(placeTileId) : kInvalidHandle;
+}
+
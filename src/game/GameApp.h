@@ -2,25 +2,41 @@
 #define DDD_GAME_GAME_APP_H
 
 #include "core/EntityManager.h"
+#include "core/TripleBuffer.h"
 #include "core/EventBus.h"
 #include "core/System.h"
+#include "managers/AnimationLibrary.h"
 #include "managers/CameraManager.h"
 #include "managers/DebugManager.h"
 #include "managers/PhysicsManager.h"
 #include "managers/ResourceManager.h"
+#include "managers/SpatialIndex.h"
 #include "managers/TimeManager.h"
 #include "managers/WindowManager.h"
+#include "managers/WorldStreamer.h"
+#include "systems/AnimationSystem.h"
 #include "systems/InputSystem.h"
 #include "systems/CameraFollowSystem.h"
+#include "systems/CharacterControllerSystem.h"
 #include "systems/DebugSystem.h"
 #include "systems/PlayerControlSystem.h"
+#include "systems/ParticleSystem.h"
 #include "systems/PhysicsSystem.h"
+#include "systems/RenderSystem.h"
 #include "systems/UIRenderSystem.h"
+#include "systems/TileChangeBatchSystem.h"
 #include "systems/TileInteractionSystem.h"
 #include "systems/InventorySystem.h"
+#include "systems/WorldStreamingSystem.h"
+#include "render/RenderSnapshot.h"
+#include "utils/Constants.h"
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 #include <filesystem>
 #include <SFML/Graphics/Rect.hpp>
@@ -35,6 +51,15 @@ class GameApp {
     void loadConfig();
     void loadResources();
     void loadMapAndEntities(const std::filesystem::path &mapPath);
+    void loadChunksAround(TilemapComponent &tilemap, const Vec2 &worldPos);
+    void stepPhysics(float dt);
+    void adaptSolverIterations();
+    void publishPhysicsStepStats();
+    void submitFrame(float dt);
+    void renderFrame(const RenderSnapshot &snapshot);
+    void startRenderThread();
+    void stopRenderThread();
+    void renderLoop();
 
     struct GameConfig {
         int windowWidth{1280};
@@ -49,6 +74,27 @@ class GameApp {
         float playerSpeed{6.0f};
         float playerJump{8.0f};
         float pickupRadius{1.5f};
+        float playerStepHeight{10.0f / RENDER_SCALE}; // world units; below one tile, so walls still need a jump
+        float playerCoyoteTime{0.1f};
+        CollisionMatrix collisionMatrix;
+        int maxPhysicsSteps{PHYSICS_MAX_STEPS_PER_FRAME};
+        float physicsBudgetMs{PHYSICS_STEP_BUDGET_MS};
+        bool adaptiveIterations{true};
+        bool atlasEnabled{true};
+        ResourceManager::AtlasSettings atlas{2048, 2, "cache/atlas"};
+        TilemapRenderMode tilemapMode{TilemapRenderMode::Chunks};
+        bool renderThreaded{true};
+        bool minimapEnabled{true};
+        WorldStreamer::Settings streaming;
+    };
+
+    // Per-frame fixed-step bookkeeping (exposed in the "physics_step" debug section).
+    struct PhysicsStepStats {
+        int steps{0};
+        float elapsedMs{0.0f};
+        int droppedSteps{0};
+        long long droppedTotal{0};
+        bool overBudget{false};
     };
 
     enum class AppScreen { MainMenu, MapSelect, Playing, PauseMenu, Settings };
@@ -92,19 +138,37 @@ class GameApp {
     CameraManager cameraManager;
     PhysicsManager physicsManager;
     ResourceManager resourceManager;
+    AnimationLibrary animationLibrary;
     TimeManager timeManager;
     DebugManager debugManager;
+    SpatialIndex spatialIndex;
+    WorldStreamer worldStreamer;
     EntityManager entityManager;
     EventBus eventBus;
 
     InputSystem *inputSystem{nullptr}; // owned by updateSystems
     InventorySystem *inventorySystem{nullptr}; // owned by updateSystems
+    ParticleSystem *particleSystem{nullptr};   // owned by updateSystems
+    RenderSystem *renderSystem{nullptr};       // owned by renderSystems
     UIRenderSystem *uiRenderSystem{nullptr};   // owned by renderSystems
     std::unique_ptr<PhysicsSystem> physicsSystem;
+    std::unique_ptr<CharacterControllerSystem> characterControllerSystem; // stepped with physics
+    float physicsAccumulator{0.0f};
+    PhysicsStepStats physicsStepStats;
 
     std::vector<std::unique_ptr<System>> updateSystems; // logic (input/player/camera/tile/debug)
     std::vector<std::unique_ptr<System>> renderSystems; // render & UI
 
+    // Simulation fills snapshots.back() and publishes it; the render thread (which owns the GL context while it
+    // runs) draws the newest one and presents. Frame counters are guarded by frameMutex.
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::thread renderThread;
+    std::mutex frameMutex;
+    std::condition_variable frameCv;
+    std::uint64_t publishedFrame{0};
+    std::uint64_t presentedFrame{0};
+    bool stopRendering{false};
+
     AppScreen screen{AppScreen::MainMenu};
     MenuRenderState menuRenderState;
     std::vector<std::filesystem::path> mapFiles;
@@ -126,6 +190,7 @@ class GameApp {
     bool loadSave(const std::filesystem::path &savePath);
     std::optional<SaveData> collectSaveData();
     bool applySaveData(const SaveData &data);
+    RegionHandle dropRegion(const TilemapComponent &map, int itemId);
     void resetWorld();
 };
 
@@ -0,0 +1,96 @@
+#ifndef DDD_MANAGERS_ANIMATION_LIBRARY_H
+#define DDD_MANAGERS_ANIMATION_LIBRARY_H
+
+#include "managers/ResourceHandles.h"
+#include "managers/ResourceManager.h"
+#include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Animation clips defined once (config/animations.json) and shared by handle. Frames are rects relative to
+// the source texture, like SpriteComponent::textureRect; the texture name is interned when the clip loads.
+class AnimationLibrary {
+  public:
+    struct Clip {
+        std::string name;
+        TextureHandle texture{kInvalidHandle};
+        std::vector<sf::IntRect> frames;
+        float frameDuration{0.1f}; // seconds
+        bool loop{true};
+    };
+
+    // Format: {"clips": {"name": {"texture": "player", "fps": 8, "loop": true,
+    //          "frames": [[x, y, w, h], ...] | "grid": {"frame_width": w, "frame_height": h, "row": r, "count": n}}}}
+    void loadFromFile(const std::string &path, ResourceManager &resources) {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            std::cerr << "Animation config not found: " << path << "\n";
+            return;
+        }
+        try {
+            nlohmann::json j;
+            in >> j;
+            if (!j.contains("clips") || !j["clips"].is_object())
+                return;
+            for (const auto &[name, c] : j["clips"].items()) {
+                Clip clip;
+                clip.name = name;
+                clip.texture = resources.textureHandle(c.value("texture", std::string{}));
+                const float fps = c.value("fps", 10.0f);
+                clip.frameDuration = fps > 0.0f ? 1.0f / fps : 0.1f;
+                clip.loop = c.value("loop", true);
+                if (c.contains("frames")) {
+                    for (const auto &f : c["frames"]) {
+                        if (f.is_array() && f.size() == 4)
+                            clip.frames.emplace_back(f[0].get<int>(), f[1].get<int>(), f[2].get<int>(),
+                                                     f[3].get<int>());
+                    }
+                } else if (c.contains("grid")) {
+                    const auto &g = c["grid"];
+                    const int w = g.value("frame_width", 0);
+                    const int h = g.value("frame_height", 0);
+                    const int row = g.value("row", 0);
+                    const int count = g.value("count", 0);
+                    for (int i = 0; i < count && w > 0 && h > 0; ++i)
+                        clip.frames.emplace_back(i * w, row * h, w, h);
+                }
+                if (clip.frames.empty()) {
+                    std::cerr << "Animation clip without frames skipped: " << name << "\n";
+                    continue;
+                }
+                add(std::move(clip));
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Failed to parse animation config " << path << ": " << e.what() << "\n";
+        }
+    }
+
+    // Replaces a clip of the same name, keeping its handle.
+    ClipHandle add(Clip clip) {
+        auto [it, inserted] = ids.emplace(clip.name, static_cast<ClipHandle>(clips.size()));
+        if (inserted)
+            clips.push_back(std::move(clip));
+        else
+            clips[it->second] = std::move(clip);
+        return it->second;
+    }
+
+    ClipHandle handle(const std::string &name) const {
+        auto it = ids.find(name);
+        return it != ids.end() ? it->second : kInvalidHandle;
+    }
+
+    const Clip *clip(ClipHandle h) const { return h < clips.size() ? &clips[h] : nullptr; }
+    std::size_t size() const { return clips.size(); }
+
+  private:
+    std::unordered_map<std::string, ClipHandle> ids;
+    std::vector<Clip> clips; // indexed by ClipHandle
+};
+
+#endif // DDD_MANAGERS_ANIMATION_LIBRARY_H
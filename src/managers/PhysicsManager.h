@@ -1,6 +1,7 @@
 #ifndef DDD_MANAGERS_PHYSICS_MANAGER_H
 #define DDD_MANAGERS_PHYSICS_MANAGER_H
 
+#include "physics/CollisionMatrix.h"
 #include "physics/PhysicsDefs.h"
 #include "utils/CoordinateUtils.h"
 #include <algorithm>
@@ -36,6 +37,7 @@ class PhysicsManager {
         fdef.friction = cfg.friction;
         fdef.restitution = cfg.restitution;
         fdef.isSensor = cfg.isSensor;
+        fdef.filter = collisionMatrix.filterFor(cfg.layer);
         fdef.userData.pointer = reinterpret_cast<uintptr_t>(tag);
 
         b2PolygonShape boxShape;
@@ -83,8 +85,13 @@ class PhysicsManager {
             world.DestroyBody(body);
     }
 
+    // Applies to fixtures created afterwards; existing fixtures keep their filters.
+    void setCollisionMatrix(const CollisionMatrix &matrix) { collisionMatrix = matrix; }
+    const CollisionMatrix &getCollisionMatrix() const { return collisionMatrix; }
+
   private:
     b2World world;
+    CollisionMatrix collisionMatrix;
 };
 
 #endif // DDD_MANAGERS_PHYSICS_MANAGER_H
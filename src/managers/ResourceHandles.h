@@ -0,0 +1,14 @@
+#ifndef DDD_MANAGERS_RESOURCE_HANDLES_H
+#define DDD_MANAGERS_RESOURCE_HANDLES_H
+
+#include <cstdint>
+
+// Dense ids interned by ResourceManager from texture / atlas region names.
+// A handle stays valid for the lifetime of the manager, even if the resource is (re)loaded later.
+using TextureHandle = std::uint32_t;
+using RegionHandle = std::uint32_t;
+using ClipHandle = std::uint32_t; // AnimationLibrary
+
+inline constexpr std::uint32_t kInvalidHandle = 0xFFFFFFFFu;
+
+#endif // DDD_MANAGERS_RESOURCE_HANDLES_H
@@ -1,17 +1,37 @@
 #ifndef DDD_MANAGERS_RESOURCE_MANAGER_H
 #define DDD_MANAGERS_RESOURCE_MANAGER_H
 
+#include "managers/ResourceHandles.h"
+#include "utils/SkylinePacker.h"
 #include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
 #include <filesystem>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class ResourceManager {
   public:
     struct AtlasRegion {
         std::string textureName;
         sf::IntRect rect;
+        TextureHandle texture{kInvalidHandle};
+    };
+
+    // Image file to be placed in an atlas page under `name` (the name sprites/regions refer to).
+    struct AtlasSource {
+        std::string name;
+        std::string path;
+    };
+
+    struct AtlasSettings {
+        int maxPageSize{2048};
+        int padding{2};
+        std::string cacheDir; // empty: never read/write the disk cache
     };
 
     void setBasePaths(const std::string &resourcesRoot, const std::string &texturesDir, const std::string &fontsDir = "fonts") {
@@ -33,16 +53,25 @@ class ResourceManager {
         if (!tex->loadFromFile(path)) {
             throw std::runtime_error("Failed to load texture: " + path);
         }
-        textures[name] = std::move(tex);
+        const sf::Vector2u size = tex->getSize();
+        TextureEntry &entry = textures[textureHandle(name)];
+        entry.owned = std::move(tex);
+        entry.texture = entry.owned.get();
+        entry.area = sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+        entry.page = kInvalidHandle;
     }
 
-    bool hasTexture(const std::string &name) const { return textures.count(name) != 0; }
+    bool hasTexture(const std::string &name) const {
+        auto it = textureIds.find(name);
+        return it != textureIds.end() && textures[it->second].texture != nullptr;
+    }
 
+    // For a texture packed into an atlas this is the whole page; see textureArea() for its sub-rectangle.
     sf::Texture &getTexture(const std::string &name) {
-        auto it = textures.find(name);
-        if (it == textures.end())
+        auto it = textureIds.find(name);
+        if (it == textureIds.end() || !textures[it->second].texture)
             throw std::runtime_error("Texture not found: " + name);
-        return *it->second;
+        return *textures[it->second].texture;
     }
 
     void loadFont(const std::string &name, const std::string &path) {
@@ -62,27 +91,259 @@ class ResourceManager {
         return *it->second;
     }
 
+    // Rects are given relative to the source texture; regions of packed textures are remapped onto the page.
     void registerAtlasRegion(const std::string &regionName, const std::string &textureName, const sf::IntRect &rect) {
-        atlas[regionName] = AtlasRegion{textureName, rect};
+        AtlasRegion region{textureName, rect, textureHandle(textureName)};
+        remapToPage(region);
+        regions[regionHandle(regionName)] = std::move(region);
     }
 
-    bool hasAtlasRegion(const std::string &regionName) const { return atlas.count(regionName) != 0; }
+    bool hasAtlasRegion(const std::string &regionName) const {
+        auto it = regionIds.find(regionName);
+        return it != regionIds.end() && regions[it->second].has_value();
+    }
 
     const AtlasRegion &getAtlasRegion(const std::string &regionName) const {
-        auto it = atlas.find(regionName);
-        if (it == atlas.end())
+        auto it = regionIds.find(regionName);
+        if (it == regionIds.end() || !regions[it->second])
             throw std::runtime_error("Atlas region not found: " + regionName);
+        return *regions[it->second];
+    }
+
+    // Interning: the name is hashed once, later lookups are plain array indexing.
+    TextureHandle textureHandle(const std::string &name) {
+        auto [it, inserted] = textureIds.emplace(name, static_cast<TextureHandle>(textures.size()));
+        if (inserted)
+            textures.emplace_back();
+        return it->second;
+    }
+
+    RegionHandle regionHandle(const std::string &name) {
+        auto [it, inserted] = regionIds.emplace(name, static_cast<RegionHandle>(regions.size()));
+        if (inserted)
+            regions.emplace_back();
         return it->second;
     }
 
+    // nullptr while the handle is invalid or its resource is not loaded/registered yet.
+    const sf::Texture *texture(TextureHandle handle) const {
+        return handle < textures.size() ? textures[handle].texture : nullptr;
+    }
+
+    // Part of texture(handle) that holds the image loaded under this handle (whole texture unless packed).
+    sf::IntRect textureArea(TextureHandle handle) const {
+        return handle < textures.size() ? textures[handle].area : sf::IntRect();
+    }
+
+    // Packs the source images into one or more `atlasName`_N pages (skyline bottom-left, tallest first).
+    // Each source name then resolves to its page plus textureArea(); already registered regions are remapped.
+    // With a cache dir the pages and placements are stored next to a signature of the source files and
+    // reused on the next start while the sources are unchanged. Sources that cannot fit stay standalone.
+    void packAtlas(const std::string &atlasName, const std::vector<AtlasSource> &sources,
+                   const AtlasSettings &settings) {
+        const std::string signature = atlasSignature(sources, settings);
+        if (!settings.cacheDir.empty() && loadAtlasCache(atlasName, sources, settings, signature))
+            return;
+
+        struct Pending {
+            const AtlasSource *source{nullptr};
+            sf::Image image;
+            int page{-1};
+            SkylinePacker::Rect rect;
+        };
+        std::vector<Pending> pending;
+        pending.reserve(sources.size());
+        for (const auto &src : sources) {
+            Pending p;
+            p.source = &src;
+            if (!p.image.loadFromFile(src.path))
+                throw std::runtime_error("Failed to load texture: " + src.path);
+            pending.push_back(std::move(p));
+        }
+        std::sort(pending.begin(), pending.end(),
+                  [](const Pending &a, const Pending &b) { return a.image.getSize().y > b.image.getSize().y; });
+
+        const int pageSize = std::min(settings.maxPageSize, static_cast<int>(sf::Texture::getMaximumSize()));
+        std::vector<SkylinePacker> packers;
+        for (auto &p : pending) {
+            const int w = static_cast<int>(p.image.getSize().x) + settings.padding * 2;
+            const int h = static_cast<int>(p.image.getSize().y) + settings.padding * 2;
+            for (std::size_t i = 0; i <= packers.size() && p.page < 0; ++i) {
+                if (i == packers.size()) {
+                    if (w > pageSize || h > pageSize)
+                        break;
+                    packers.emplace_back(pageSize, pageSize);
+                }
+                if (auto placed = packers[i].insert(w, h)) {
+                    p.page = static_cast<int>(i);
+                    p.rect = SkylinePacker::Rect{placed->x + settings.padding, placed->y + settings.padding,
+                                                 static_cast<int>(p.image.getSize().x),
+                                                 static_cast<int>(p.image.getSize().y)};
+                }
+            }
+        }
+
+        std::vector<sf::Image> pages(packers.size());
+        for (std::size_t i = 0; i < packers.size(); ++i)
+            pages[i].create(static_cast<unsigned>(pageSize), static_cast<unsigned>(packers[i].getUsedHeight()),
+                            sf::Color::Transparent);
+        for (const auto &p : pending) {
+            if (p.page >= 0)
+                pages[p.page].copy(p.image, static_cast<unsigned>(p.rect.x), static_cast<unsigned>(p.rect.y));
+        }
+
+        nlohmann::json manifest;
+        manifest["signature"] = signature;
+        manifest["pages"] = nlohmann::json::array();
+        // The manifest is only written when every page reached the cache, so a later start never trusts it
+        // with pages missing.
+        bool cacheable = !settings.cacheDir.empty();
+        if (cacheable) {
+            std::error_code ec;
+            std::filesystem::create_directories(settings.cacheDir, ec);
+        }
+        std::vector<TextureHandle> pageHandles;
+        for (std::size_t i = 0; i < pages.size(); ++i) {
+            const std::string pageName = atlasName + "_" + std::to_string(i);
+            pageHandles.push_back(adoptPage(pageName, pages[i]));
+            manifest["pages"].push_back(pageName + ".png");
+            if (cacheable &&
+                !pages[i].saveToFile((std::filesystem::path(settings.cacheDir) / (pageName + ".png")).string()))
+                cacheable = false;
+        }
+
+        for (const auto &p : pending) {
+            if (p.page < 0) {
+                std::cerr << "Atlas " << atlasName << ": " << p.source->name << " does not fit, kept standalone\n";
+                loadTexture(p.source->name, p.source->path);
+                continue;
+            }
+            const sf::IntRect area{p.rect.x, p.rect.y, p.rect.w, p.rect.h};
+            placeInPage(p.source->name, pageHandles[p.page], area);
+            manifest["entries"][p.source->name] = {{"page", p.page},
+                                                   {"rect", {area.left, area.top, area.width, area.height}}};
+        }
+
+        if (cacheable) {
+            std::ofstream out(std::filesystem::path(settings.cacheDir) / (atlasName + ".json"));
+            if (out)
+                out << manifest.dump(2);
+        }
+    }
+
+    const AtlasRegion *region(RegionHandle handle) const {
+        return handle < regions.size() && regions[handle] ? &*regions[handle] : nullptr;
+    }
+
   private:
+    struct TextureEntry {
+        std::unique_ptr<sf::Texture> owned; // standalone texture or atlas page
+        sf::Texture *texture{nullptr};      // owned.get(), or the page this image was packed into
+        sf::IntRect area;                   // where the image lives inside *texture
+        TextureHandle page{kInvalidHandle}; // set when packed
+    };
+
+    TextureHandle adoptPage(const std::string &pageName, const sf::Image &image) {
+        auto tex = std::make_unique<sf::Texture>();
+        if (!tex->loadFromImage(image))
+            throw std::runtime_error("Failed to create atlas page: " + pageName);
+        const sf::Vector2u size = tex->getSize();
+        const TextureHandle handle = textureHandle(pageName);
+        TextureEntry &entry = textures[handle];
+        entry.owned = std::move(tex);
+        entry.texture = entry.owned.get();
+        entry.area = sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+        entry.page = kInvalidHandle;
+        return handle;
+    }
+
+    void placeInPage(const std::string &name, TextureHandle page, const sf::IntRect &area) {
+        const TextureHandle handle = textureHandle(name);
+        TextureEntry &entry = textures[handle];
+        entry.owned.reset();
+        entry.texture = textures[page].texture;
+        entry.area = area;
+        entry.page = page;
+        for (auto &region : regions) {
+            if (region && region->texture == handle)
+                remapToPage(*region);
+        }
+    }
+
+    void remapToPage(AtlasRegion &region) const {
+        const TextureEntry &entry = textures[region.texture];
+        if (entry.page == kInvalidHandle)
+            return;
+        region.rect.left += entry.area.left;
+        region.rect.top += entry.area.top;
+        region.texture = entry.page;
+        for (const auto &[name, handle] : textureIds) {
+            if (handle == entry.page) {
+                region.textureName = name;
+                break;
+            }
+        }
+    }
+
+    static std::string atlasSignature(const std::vector<AtlasSource> &sources, const AtlasSettings &settings) {
+        std::string sig = std::to_string(settings.maxPageSize) + "/" + std::to_string(settings.padding);
+        for (const auto &src : sources) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(src.path, ec);
+            const auto stamp = std::filesystem::last_write_time(src.path, ec).time_since_epoch().count();
+            sig += ";" + src.name + "=" + src.path + ":" + std::to_string(size) + ":" + std::to_string(stamp);
+        }
+        return sig;
+    }
+
+    bool loadAtlasCache(const std::string &atlasName, const std::vector<AtlasSource> &sources,
+                        const AtlasSettings &settings, const std::string &signature) {
+        const std::filesystem::path dir(settings.cacheDir);
+        std::ifstream in(dir / (atlasName + ".json"));
+        if (!in)
+            return false;
+        try {
+            nlohmann::json manifest;
+            in >> manifest;
+            if (manifest.value("signature", std::string{}) != signature)
+                return false;
+
+            std::vector<sf::Image> pages(manifest["pages"].size());
+            for (std::size_t i = 0; i < pages.size(); ++i) {
+                if (!pages[i].loadFromFile((dir / manifest["pages"][i].get<std::string>()).string()))
+                    return false;
+            }
+            std::vector<TextureHandle> pageHandles;
+            for (std::size_t i = 0; i < pages.size(); ++i)
+                pageHandles.push_back(adoptPage(atlasName + "_" + std::to_string(i), pages[i]));
+
+            const auto &entries = manifest["entries"];
+            for (const auto &src : sources) {
+                if (!entries.contains(src.name)) {
+                    loadTexture(src.name, src.path);
+                    continue;
+                }
+                const auto &e = entries[src.name];
+                const auto &r = e["rect"];
+                placeInPage(src.name, pageHandles.at(e["page"].get<std::size_t>()),
+                            sf::IntRect(r[0].get<int>(), r[1].get<int>(), r[2].get<int>(), r[3].get<int>()));
+            }
+            return true;
+        } catch (const std::exception &e) {
+            std::cerr << "Atlas cache " << atlasName << " ignored: " << e.what() << "\n";
+            return false;
+        }
+    }
+
     std::string resourcesPath{"resources"};
     std::string texturesPath{"textures"};
     std::string fontsPath{"fonts"};
 
-    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures;
+    std::unordered_map<std::string, TextureHandle> textureIds;
+    std::vector<TextureEntry> textures; // indexed by TextureHandle
     std::unordered_map<std::string, std::unique_ptr<sf::Font>> fonts;
-    std::unordered_map<std::string, AtlasRegion> atlas;
+    std::unordered_map<std::string, RegionHandle> regionIds;
+    std::vector<std::optional<AtlasRegion>> regions; // indexed by RegionHandle
 };
 
 #endif // DDD_MANAGERS_RESOURCE_MANAGER_H
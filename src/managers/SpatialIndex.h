@@ -0,0 +1,177 @@
+#ifndef DDD_MANAGERS_SPATIAL_INDEX_H
+#define DDD_MANAGERS_SPATIAL_INDEX_H
+
+#include "core/Entity.h"
+#include "utils/Vec2.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Uniform hash grid over entity positions (world units).
+// Entries are upserted from physics sync and carry a category mask (CollisionMatrix::categoryBit),
+// so queries can filter e.g. drops only. Queries invoke a visitor and never allocate.
+class SpatialIndex {
+  public:
+    static constexpr std::uint32_t kAllCategories = 0xFFFFFFFFu;
+
+    explicit SpatialIndex(float cell = 2.0f) : cellSize(cell), invCellSize(1.0f / cell) {}
+
+    void update(Entity::Id id, const Vec2 &pos, std::uint32_t categories) {
+        const CellKey key = keyFor(pos);
+        auto it = entries.find(id);
+        if (it != entries.end()) {
+            EntryRef &ref = it->second;
+            if (ref.cell == key) {
+                Item &item = cells[key][ref.slot];
+                item.pos = pos;
+                item.categories = categories;
+                return;
+            }
+            detach(ref);
+            ref = attach(key, Item{id, pos, categories});
+            return;
+        }
+        entries.emplace(id, attach(key, Item{id, pos, categories}));
+    }
+
+    void remove(Entity::Id id) {
+        auto it = entries.find(id);
+        if (it == entries.end())
+            return;
+        detach(it->second);
+        entries.erase(it);
+    }
+
+    void clear() {
+        cells.clear();
+        entries.clear();
+    }
+
+    bool contains(Entity::Id id) const { return entries.count(id) != 0; }
+    std::size_t size() const { return entries.size(); }
+
+    // fn(Entity::Id, const Vec2 &pos) for every entry inside [min, max].
+    template <typename Fn> void queryAABB(const Vec2 &min, const Vec2 &max, std::uint32_t mask, Fn &&fn) const {
+        const int cx0 = cellCoord(min.x);
+        const int cy0 = cellCoord(min.y);
+        const int cx1 = cellCoord(max.x);
+        const int cy1 = cellCoord(max.y);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                auto it = cells.find(packKey(cx, cy));
+                if (it == cells.end())
+                    continue;
+                for (const Item &item : it->second) {
+                    if ((item.categories & mask) == 0)
+                        continue;
+                    if (item.pos.x < min.x || item.pos.x > max.x || item.pos.y < min.y || item.pos.y > max.y)
+                        continue;
+                    fn(item.id, item.pos);
+                }
+            }
+        }
+    }
+
+    template <typename Fn> void queryRadius(const Vec2 &center, float radius, std::uint32_t mask, Fn &&fn) const {
+        const float r2 = radius * radius;
+        queryAABB(Vec2{center.x - radius, center.y - radius}, Vec2{center.x + radius, center.y + radius}, mask,
+                  [&](Entity::Id id, const Vec2 &pos) {
+                      const float dx = pos.x - center.x;
+                      const float dy = pos.y - center.y;
+                      if (dx * dx + dy * dy <= r2)
+                          fn(id, pos);
+                  });
+    }
+
+    // Closest entry within maxRadius; scans grid rings outward and stops once no closer cell can exist.
+    std::optional<Entity::Id> nearest(const Vec2 &center, float maxRadius, std::uint32_t mask,
+                                      Entity::Id exclude = std::numeric_limits<Entity::Id>::max()) const {
+        const int ccx = cellCoord(center.x);
+        const int ccy = cellCoord(center.y);
+        const int maxRing = static_cast<int>(std::ceil(maxRadius * invCellSize)) + 1;
+        float best2 = maxRadius * maxRadius;
+        std::optional<Entity::Id> best;
+
+        for (int ring = 0; ring <= maxRing; ++ring) {
+            // Any entry in this ring is at least (ring - 1) cells away from the center.
+            const float ringDist = static_cast<float>(ring - 1) * cellSize;
+            if (ring > 1 && ringDist * ringDist > best2)
+                break;
+            for (int cy = ccy - ring; cy <= ccy + ring; ++cy) {
+                const bool edgeRow = (cy == ccy - ring || cy == ccy + ring);
+                const int step = edgeRow ? 1 : 2 * ring;
+                for (int cx = ccx - ring; cx <= ccx + ring; cx += (step > 0 ? step : 1)) {
+                    auto it = cells.find(packKey(cx, cy));
+                    if (it == cells.end())
+                        continue;
+                    for (const Item &item : it->second) {
+                        if ((item.categories & mask) == 0 || item.id == exclude)
+                            continue;
+                        const float dx = item.pos.x - center.x;
+                        const float dy = item.pos.y - center.y;
+                        const float d2 = dx * dx + dy * dy;
+                        if (d2 <= best2) {
+                            best2 = d2;
+                            best = item.id;
+                        }
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+  private:
+    using CellKey = std::uint64_t;
+
+    struct Item {
+        Entity::Id id{0};
+        Vec2 pos{};
+        std::uint32_t categories{0};
+    };
+
+    struct EntryRef {
+        CellKey cell{0};
+        std::size_t slot{0};
+    };
+
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v * invCellSize)); }
+
+    static CellKey packKey(int cx, int cy) {
+        return (static_cast<CellKey>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+    }
+
+    CellKey keyFor(const Vec2 &pos) const { return packKey(cellCoord(pos.x), cellCoord(pos.y)); }
+
+    EntryRef attach(CellKey key, const Item &item) {
+        std::vector<Item> &cell = cells[key];
+        cell.push_back(item);
+        return EntryRef{key, cell.size() - 1};
+    }
+
+    // Swap-and-pop; keeps the moved item's slot in sync. Empty cells are dropped so the map tracks occupancy.
+    void detach(const EntryRef &ref) {
+        auto cellIt = cells.find(ref.cell);
+        if (cellIt == cells.end())
+            return;
+        std::vector<Item> &cell = cellIt->second;
+        const std::size_t last = cell.size() - 1;
+        if (ref.slot != last) {
+            cell[ref.slot] = cell[last];
+            entries[cell[ref.slot].id].slot = ref.slot;
+        }
+        cell.pop_back();
+        if (cell.empty())
+            cells.erase(cellIt);
+    }
+
+    float cellSize{2.0f};
+    float invCellSize{0.5f};
+    std::unordered_map<CellKey, std::vector<Item>> cells;
+    std::unordered_map<Entity::Id, EntryRef> entries;
+};
+
+#endif // DDD_MANAGERS_SPATIAL_INDEX_H
@@ -17,10 +17,9 @@ class WindowManager {
     sf::RenderWindow &getWindow() { return window; }
     const sf::RenderWindow &getWindow() const { return window; }
 
-    void setView(const sf::View &v) {
-        view = v;
-        window.setView(view);
-    }
+    // World view of the current frame. Only stored here: the render pass applies it to the window,
+    // which may be owned by the render thread.
+    void setView(const sf::View &v) { view = v; }
 
     sf::View &getView() { return view; }
     const sf::View &getView() const { return view; }
@@ -0,0 +1,306 @@
+#ifndef DDD_MANAGERS_WORLD_STREAMER_H
+#define DDD_MANAGERS_WORLD_STREAMER_H
+
+#include "utils/RegionFile.h"
+#include "utils/TileChunkStore.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Streams tilemap chunks between a TileChunkStore and region files. Each world keeps two region directories
+// under <cacheDir>/<name>: "base" (the map converted once, reused while its stamp matches) and "session"
+// (chunks evicted with edits, wiped whenever the world is opened); a chunk is read from session first.
+// Reads and write-backs run on one worker thread in FIFO order, so a reload always sees the latest eviction.
+// Every other method belongs to the main thread.
+class WorldStreamer {
+  public:
+    struct Settings {
+        bool enabled{true};  // false: every chunk is loaded on open and never evicted
+        int radiusChunks{3}; // kept resident around each focus; evicted beyond radius + 1
+        std::string cacheDir{"cache/world"};
+    };
+
+    struct ChunkCoord {
+        int x{0};
+        int y{0};
+    };
+
+    WorldStreamer() = default;
+    WorldStreamer(const WorldStreamer &) = delete;
+    WorldStreamer &operator=(const WorldStreamer &) = delete;
+    ~WorldStreamer() { stop(); }
+
+    void setSettings(const Settings &s) { settings = s; }
+    const Settings &getSettings() const { return settings; }
+
+    // Starts a world of chunksX x chunksY chunks: drops in-flight loads of the previous one, waits for its writes
+    // and wipes the session regions. Returns true when the base regions were written from the same `stamp`.
+    bool open(const std::string &name, const std::string &stamp, int chunksXCount, int chunksYCount, int empty) {
+        startWorker();
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++generation;
+            results.clear();
+        }
+        pendingLoads.clear();
+        const std::filesystem::path root = std::filesystem::path(settings.cacheDir) / name;
+        baseDir = root / "base";
+        sessionDir = root / "session";
+        chunksX = chunksXCount;
+        chunksY = chunksYCount;
+        emptyId = empty;
+        std::error_code ec;
+        std::filesystem::remove_all(sessionDir, ec);
+
+        std::ifstream in(baseDir / "stamp.txt");
+        std::string stored;
+        return in.is_open() && std::getline(in, stored) && stored == versionedStamp(stamp);
+    }
+
+    // Replaces the base regions, one region at a time so memory stays bounded for large worlds:
+    // fillRegion(cx0, cy0, cx1, cy1, chunks) fills chunks[(cy - cy0) * (cx1 - cx0) + (cx - cx0)] for the
+    // half-open chunk range with kChunkArea ids each; they are palette-compressed before writing.
+    template <typename FillRegion> void writeBase(const std::string &stamp, FillRegion &&fillRegion) {
+        std::lock_guard<std::mutex> io(ioMutex);
+        std::error_code ec;
+        std::filesystem::remove_all(baseDir, ec);
+        std::vector<std::vector<int>> chunks;
+        std::vector<TileChunk> packed;
+        for (int ry = 0; ry * RegionFile::kRegionSize < chunksY; ++ry) {
+            for (int rx = 0; rx * RegionFile::kRegionSize < chunksX; ++rx) {
+                const int cx0 = rx * RegionFile::kRegionSize;
+                const int cy0 = ry * RegionFile::kRegionSize;
+                const int cx1 = std::min(cx0 + RegionFile::kRegionSize, chunksX);
+                const int cy1 = std::min(cy0 + RegionFile::kRegionSize, chunksY);
+                chunks.resize(static_cast<std::size_t>((cx1 - cx0) * (cy1 - cy0)));
+                fillRegion(cx0, cy0, cx1, cy1, chunks);
+                packed.resize(chunks.size());
+                std::array<const TileChunk *, RegionFile::kSlots> slots{};
+                for (int cy = cy0; cy < cy1; ++cy) {
+                    for (int cx = cx0; cx < cx1; ++cx) {
+                        const std::size_t i = static_cast<std::size_t>((cy - cy0) * (cx1 - cx0) + (cx - cx0));
+                        if (chunks[i].size() != static_cast<std::size_t>(TileChunkStore::kChunkArea))
+                            continue;
+                        packed[i].assign(chunks[i].data());
+                        slots[RegionFile::slotIndex(cx, cy)] = &packed[i];
+                    }
+                }
+                RegionFile::writeRegion(baseDir, rx, ry, slots);
+            }
+        }
+        std::ofstream out(baseDir / "stamp.txt", std::ios::trunc);
+        out << versionedStamp(stamp) << "\n";
+    }
+
+    // Converts a row-major width x height map into base regions (edge chunks padded with the empty id).
+    void writeBase(const std::vector<int> &tiles, int width, int height, const std::string &stamp) {
+        writeBase(stamp, [&](int cx0, int cy0, int cx1, int cy1, std::vector<std::vector<int>> &chunks) {
+            for (int cy = cy0; cy < cy1; ++cy) {
+                for (int cx = cx0; cx < cx1; ++cx) {
+                    std::vector<int> &chunk = chunks[(cy - cy0) * (cx1 - cx0) + (cx - cx0)];
+                    chunk.assign(TileChunkStore::kChunkArea, emptyId);
+                    const int x0 = cx * TileChunkStore::kChunkSize;
+                    const int y0 = cy * TileChunkStore::kChunkSize;
+                    const int x1 = std::min(x0 + TileChunkStore::kChunkSize, width);
+                    const int y1 = std::min(y0 + TileChunkStore::kChunkSize, height);
+                    for (int y = y0; y < y1; ++y)
+                        std::copy(tiles.begin() + y * width + x0, tiles.begin() + y * width + x1,
+                                  chunk.begin() + TileChunkStore::localIndex(x0, y));
+                }
+            }
+        });
+    }
+
+    // Synchronously makes every chunk of [cx0, cx1] x [cy0, cy1] resident (clamped to the world).
+    void loadNow(TileChunkStore &store, int cx0, int cy0, int cx1, int cy1) {
+        flush();
+        for (int cy = std::max(0, cy0); cy <= std::min(cy1, chunksY - 1); ++cy) {
+            for (int cx = std::max(0, cx0); cx <= std::min(cx1, chunksX - 1); ++cx) {
+                if (store.find(cx, cy))
+                    continue;
+                TileChunk chunk;
+                readChunk(cx, cy, chunk);
+                store.insert(cx, cy, std::move(chunk));
+            }
+        }
+    }
+
+    void loadAll(TileChunkStore &store) { loadNow(store, 0, 0, chunksX - 1, chunksY - 1); }
+
+    // Once per frame: takes finished loads, queues loads for missing chunks within max(radiusChunks, viewRadius)
+    // of any focus and writes back / evicts chunks that left the range. Chunks that became resident or were
+    // evicted are appended to `loaded` / `unloaded`.
+    void update(TileChunkStore &store, const std::vector<ChunkCoord> &focus, int viewRadius,
+                std::vector<ChunkCoord> &loaded, std::vector<ChunkCoord> &unloaded) {
+        std::vector<Result> done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done.swap(results);
+        }
+        for (Result &r : done) {
+            pendingLoads.erase(TileChunkStore::key(r.cx, r.cy));
+            if (store.find(r.cx, r.cy))
+                continue; // loaded synchronously in the meantime
+            store.insert(r.cx, r.cy, std::move(r.chunk));
+            loaded.push_back({r.cx, r.cy});
+        }
+        if (!settings.enabled || focus.empty())
+            return;
+
+        const int radius = std::max(settings.radiusChunks, viewRadius);
+        for (const ChunkCoord &f : focus) {
+            for (int cy = std::max(0, f.y - radius); cy <= std::min(f.y + radius, chunksY - 1); ++cy) {
+                for (int cx = std::max(0, f.x - radius); cx <= std::min(f.x + radius, chunksX - 1); ++cx) {
+                    const TileChunkStore::Key k = TileChunkStore::key(cx, cy);
+                    if (store.find(k) || !pendingLoads.insert(k).second)
+                        continue;
+                    enqueue(Job{Job::Kind::Load, cx, cy, {}});
+                }
+            }
+        }
+
+        evictScratch.clear();
+        store.forEach([&](TileChunkStore::Key k, TileChunk &) {
+            const int cx = TileChunkStore::keyX(k);
+            const int cy = TileChunkStore::keyY(k);
+            const bool near = std::any_of(focus.begin(), focus.end(), [&](const ChunkCoord &f) {
+                return std::max(std::abs(cx - f.x), std::abs(cy - f.y)) <= radius + 1;
+            });
+            if (!near)
+                evictScratch.push_back({cx, cy});
+        });
+        for (const ChunkCoord &c : evictScratch) {
+            TileChunk *chunk = store.find(c.x, c.y);
+            if (chunk->dirty)
+                enqueue(Job{Job::Kind::Save, c.x, c.y, std::move(*chunk)});
+            store.erase(c.x, c.y);
+            unloaded.push_back(c);
+        }
+    }
+
+    // Blocks until every queued job has finished.
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return jobs.empty() && !busy; });
+    }
+
+    // Chunk as a load would see it now (session, then base, else empty); call flush() first if evictions may
+    // still be queued.
+    void readChunk(int cx, int cy, TileChunk &chunk) {
+        std::lock_guard<std::mutex> io(ioMutex);
+        if (!RegionFile::read(sessionDir, cx, cy, chunk) && !RegionFile::read(baseDir, cx, cy, chunk))
+            chunk.reset(emptyId);
+        chunk.dirty = false;
+    }
+
+    std::size_t pendingLoadCount() const { return pendingLoads.size(); }
+
+    // Finishes queued jobs and joins the worker.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (worker.joinable())
+            worker.join();
+        stopping = false;
+    }
+
+  private:
+    struct Job {
+        enum class Kind { Load, Save } kind{Kind::Load};
+        int cx{0};
+        int cy{0};
+        TileChunk chunk; // Save only
+        std::uint64_t generation{0};
+    };
+
+    struct Result {
+        int cx{0};
+        int cy{0};
+        TileChunk chunk;
+    };
+
+    // Caches written by an older region format are converted again.
+    static std::string versionedStamp(const std::string &stamp) {
+        return stamp + ":r" + std::to_string(RegionFile::kVersion);
+    }
+
+    void startWorker() {
+        if (!worker.joinable())
+            worker = std::thread([this] { workerLoop(); });
+    }
+
+    void enqueue(Job job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job.generation = generation;
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty())
+                return; // stopping with nothing left to write
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+            lock.unlock();
+
+            Result result{job.cx, job.cy, {}};
+            if (job.kind == Job::Kind::Save) {
+                std::lock_guard<std::mutex> io(ioMutex);
+                RegionFile::write(sessionDir, job.cx, job.cy, job.chunk);
+            } else {
+                readChunk(job.cx, job.cy, result.chunk);
+            }
+
+            lock.lock();
+            if (job.kind == Job::Kind::Load && job.generation == generation)
+                results.push_back(std::move(result));
+            busy = false;
+            idle.notify_all();
+        }
+    }
+
+    Settings settings;
+    std::filesystem::path baseDir;
+    std::filesystem::path sessionDir;
+    int chunksX{0};
+    int chunksY{0};
+    int emptyId{-1};
+    std::unordered_set<TileChunkStore::Key> pendingLoads; // main thread
+    std::vector<ChunkCoord> evictScratch;
+
+    std::thread worker;
+    std::mutex mutex; // jobs, results, generation, busy, stopping
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<Job> jobs;
+    std::vector<Result> results;
+    std::uint64_t generation{0};
+    bool busy{false};
+    bool stopping{false};
+    std::mutex ioMutex; // region files; also taken by main-thread reads
+};
+
+#endif // DDD_MANAGERS_WORLD_STREAMER_H
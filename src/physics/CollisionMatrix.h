@@ -0,0 +1,81 @@
+#ifndef DDD_PHYSICS_COLLISION_MATRIX_H
+#define DDD_PHYSICS_COLLISION_MATRIX_H
+
+#include "physics/PhysicsDefs.h"
+#include <array>
+#include <box2d/box2d.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// Symmetric layer-vs-layer collision table compiled into one b2Filter per layer.
+// Filters are built once (on config load) and copied into b2FixtureDef at fixture creation.
+class CollisionMatrix {
+  public:
+    static constexpr std::size_t kLayerCount = static_cast<std::size_t>(CollisionLayer::Count);
+
+    CollisionMatrix() { setAll(true); }
+
+    static std::uint16_t categoryBit(CollisionLayer layer) {
+        return static_cast<std::uint16_t>(1u << static_cast<unsigned>(layer));
+    }
+
+    static std::optional<CollisionLayer> parseLayer(const std::string &name) {
+        if (name == "default")
+            return CollisionLayer::Default;
+        if (name == "player")
+            return CollisionLayer::Player;
+        if (name == "drop")
+            return CollisionLayer::Drop;
+        if (name == "tile")
+            return CollisionLayer::Tile;
+        if (name == "projectile")
+            return CollisionLayer::Projectile;
+        if (name == "sensor")
+            return CollisionLayer::Sensor;
+        return std::nullopt;
+    }
+
+    void setAll(bool collide) {
+        const std::uint16_t mask = collide ? allCategories() : 0;
+        masks.fill(mask);
+        compile();
+    }
+
+    void setCollides(CollisionLayer a, CollisionLayer b, bool collide) {
+        std::uint16_t &maskA = masks[index(a)];
+        std::uint16_t &maskB = masks[index(b)];
+        if (collide) {
+            maskA |= categoryBit(b);
+            maskB |= categoryBit(a);
+        } else {
+            maskA &= static_cast<std::uint16_t>(~categoryBit(b));
+            maskB &= static_cast<std::uint16_t>(~categoryBit(a));
+        }
+        compile();
+    }
+
+    bool collides(CollisionLayer a, CollisionLayer b) const { return (masks[index(a)] & categoryBit(b)) != 0; }
+
+    const b2Filter &filterFor(CollisionLayer layer) const { return filters[index(layer)]; }
+
+  private:
+    static std::size_t index(CollisionLayer layer) { return static_cast<std::size_t>(layer); }
+    static std::uint16_t allCategories() { return static_cast<std::uint16_t>((1u << kLayerCount) - 1u); }
+
+    void compile() {
+        for (std::size_t i = 0; i < kLayerCount; ++i) {
+            b2Filter filter;
+            filter.categoryBits = categoryBit(static_cast<CollisionLayer>(i));
+            filter.maskBits = masks[i];
+            filter.groupIndex = 0;
+            filters[i] = filter;
+        }
+    }
+
+    std::array<std::uint16_t, kLayerCount> masks{};
+    std::array<b2Filter, kLayerCount> filters{};
+};
+
+#endif // DDD_PHYSICS_COLLISION_MATRIX_H
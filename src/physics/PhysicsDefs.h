@@ -3,10 +3,14 @@
 
 #include "utils/Vec2.h"
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 enum class PhysicsShapeType { Box, Circle, Polygon };
 
+// Named collision layers; each maps to one Box2D category bit (see CollisionMatrix).
+enum class CollisionLayer : std::uint8_t { Default, Player, Drop, Tile, Projectile, Sensor, Count };
+
 struct PhysicsFixtureConfig {
     PhysicsShapeType shape{PhysicsShapeType::Box};
     Vec2 size{1.0f, 1.0f};        // full width/height in world units (used for boxes)
@@ -20,13 +24,14 @@ struct PhysicsFixtureConfig {
     float angularDamping{0.0f};
     bool canRotate{true};
     bool isSensor{false};
-    bool isFootSensor{false};
+    CollisionLayer layer{CollisionLayer::Default};
 };
 
 struct FixtureTag {
     std::size_t entityId{0};
+    CollisionLayer layer{CollisionLayer::Default};
     bool isSensor{false};
-    bool isFootSensor{false};
+    bool reportContacts{false}; // emit ContactEvent for this fixture regardless of layer interest
 };
 
 #endif // DDD_PHYSICS_PHYSICS_DEFS_H
@@ -0,0 +1,165 @@
+#include "render/Minimap.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+void Minimap::clear() {
+    ready = false;
+    width = height = 0;
+    palette.clear();
+    pixels.clear();
+    staging.clear();
+}
+
+sf::Color Minimap::averageColor(const sf::Image &image, const sf::IntRect &rect) {
+    const sf::Vector2u size = image.getSize();
+    unsigned long r = 0, g = 0, b = 0, weight = 0;
+    for (int y = std::max(0, rect.top); y < std::min<int>(size.y, rect.top + rect.height); ++y) {
+        for (int x = std::max(0, rect.left); x < std::min<int>(size.x, rect.left + rect.width); ++x) {
+            const sf::Color c = image.getPixel(static_cast<unsigned>(x), static_cast<unsigned>(y));
+            r += c.r * c.a;
+            g += c.g * c.a;
+            b += c.b * c.a;
+            weight += c.a;
+        }
+    }
+    if (weight == 0)
+        return sf::Color::Transparent;
+    return sf::Color(static_cast<sf::Uint8>(r / weight), static_cast<sf::Uint8>(g / weight),
+                     static_cast<sf::Uint8>(b / weight));
+}
+
+void Minimap::reset(const TilemapComponent &tilemap, const TileSources &sources) {
+    clear();
+    const unsigned maxSize = sf::Texture::getMaximumSize();
+    if (tilemap.width <= 0 || tilemap.height <= 0 || static_cast<unsigned>(tilemap.width) > maxSize ||
+        static_cast<unsigned>(tilemap.height) > maxSize)
+        return;
+
+    width = tilemap.width;
+    height = tilemap.height;
+    emptyId = tilemap.emptyId;
+    origin = {tilemap.origin.x, tilemap.origin.y};
+    tileSize = tilemap.tileSize;
+
+    // One GPU readback per texture at load time; tile colours are fixed afterwards.
+    std::unordered_map<const sf::Texture *, sf::Image> images;
+    palette.assign(static_cast<std::size_t>(std::max(0, sources.size())), sf::Color::Transparent);
+    for (int id = 0; id < sources.size(); ++id) {
+        const TileSources::Source *source = sources.find(id);
+        if (!source)
+            continue;
+        auto it = images.find(source->texture);
+        if (it == images.end())
+            it = images.emplace(source->texture, source->texture->copyToImage()).first;
+        palette[id] = averageColor(it->second, source->rect);
+    }
+
+    pixels.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const sf::Color c = colorFor(tilemap.get(x, y));
+            sf::Uint8 *px = &pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+            px[0] = c.r;
+            px[1] = c.g;
+            px[2] = c.b;
+            px[3] = c.a;
+        }
+    }
+    if (!texture.create(static_cast<unsigned>(width), static_cast<unsigned>(height)))
+        return;
+    texture.setSmooth(false);
+    texture.update(pixels.data());
+    ready = true;
+}
+
+sf::Color Minimap::colorFor(int tileId) const {
+    if (tileId < 0 || tileId == emptyId)
+        return sf::Color::Transparent;
+    if (tileId < static_cast<int>(palette.size()) && palette[tileId].a != 0)
+        return palette[tileId];
+    // Ids without a loaded region still show up, in a stable colour of their own.
+    const unsigned h = static_cast<unsigned>(tileId) * 2654435761u;
+    return sf::Color(static_cast<sf::Uint8>(96 + (h >> 24) % 128), static_cast<sf::Uint8>(96 + (h >> 16) % 128),
+                     static_cast<sf::Uint8>(96 + (h >> 8) % 128));
+}
+
+void Minimap::paintTile(int x, int y, int tileId) {
+    if (!ready || x < 0 || y < 0 || x >= width || y >= height)
+        return;
+    const sf::Color c = colorFor(tileId);
+    sf::Uint8 *px = &pixels[(static_cast<std::size_t>(y) * width + x) * 4];
+    px[0] = c.r;
+    px[1] = c.g;
+    px[2] = c.b;
+    px[3] = c.a;
+}
+
+void Minimap::upload(const sf::IntRect &area) {
+    if (!ready)
+        return;
+    const int x0 = std::max(0, area.left);
+    const int y0 = std::max(0, area.top);
+    const int x1 = std::min(width, area.left + area.width);
+    const int y1 = std::min(height, area.top + area.height);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+    const int w = x1 - x0;
+    const int h = y1 - y0;
+    const sf::Uint8 *src = &pixels[(static_cast<std::size_t>(y0) * width + x0) * 4];
+    if (h > 1 && w < width) {
+        // sf::Texture::update wants tightly packed rows; a single row already is, wider areas are gathered.
+        const std::size_t rowBytes = static_cast<std::size_t>(w) * 4;
+        staging.resize(rowBytes * static_cast<std::size_t>(h));
+        for (int row = 0; row < h; ++row)
+            std::copy_n(src + static_cast<std::size_t>(row) * width * 4, rowBytes, &staging[row * rowBytes]);
+        src = staging.data();
+    }
+    texture.update(src, static_cast<unsigned>(w), static_cast<unsigned>(h), static_cast<unsigned>(x0),
+                   static_cast<unsigned>(y0));
+}
+
+void Minimap::draw(sf::RenderTarget &target, const sf::FloatRect &frame,
+                   const std::vector<MinimapMarker> &markers) const {
+    if (!ready)
+        return;
+
+    sf::RectangleShape bg;
+    bg.setPosition(frame.left, frame.top);
+    bg.setSize({frame.width, frame.height});
+    bg.setFillColor(sf::Color(0x20, 0x25, 0x2b, 200));
+    bg.setOutlineThickness(2.0f);
+    bg.setOutlineColor(sf::Color(0x4a, 0x55, 0x60));
+    target.draw(bg);
+
+    const float scale = std::min(frame.width / static_cast<float>(width), frame.height / static_cast<float>(height));
+    const sf::Vector2f mapSize(static_cast<float>(width) * scale, static_cast<float>(height) * scale);
+    const sf::Vector2f mapPos(frame.left + (frame.width - mapSize.x) * 0.5f,
+                              frame.top + (frame.height - mapSize.y) * 0.5f);
+    sf::Sprite sprite(texture);
+    sprite.setPosition(mapPos);
+    sprite.setScale(scale, scale);
+    target.draw(sprite);
+
+    // Markers keep a minimum on-screen size however far the map is scaled down.
+    std::vector<sf::Vertex> quads;
+    quads.reserve(markers.size() * 6);
+    for (const MinimapMarker &marker : markers) {
+        const float tx = (marker.position.x - origin.x) / tileSize;
+        const float ty = (origin.y - marker.position.y) / tileSize; // data y grows downward
+        if (tx < 0.0f || ty < 0.0f || tx >= static_cast<float>(width) || ty >= static_cast<float>(height))
+            continue;
+        const bool player = marker.kind == MinimapMarker::Kind::Player;
+        const float half = player ? 3.0f : 1.5f;
+        const sf::Color color = player ? sf::Color(0x6f, 0xa3, 0xd8) : sf::Color(0xf0, 0xd0, 0x50);
+        const float cx = mapPos.x + tx * scale;
+        const float cy = mapPos.y + ty * scale;
+        const sf::Vertex tl({cx - half, cy - half}, color);
+        const sf::Vertex tr({cx + half, cy - half}, color);
+        const sf::Vertex br({cx + half, cy + half}, color);
+        const sf::Vertex bl({cx - half, cy + half}, color);
+        quads.insert(quads.end(), {tl, tr, br, tl, br, bl});
+    }
+    if (!quads.empty())
+        target.draw(quads.data(), quads.size(), sf::Triangles);
+}
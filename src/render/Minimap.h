@@ -0,0 +1,43 @@
+#ifndef DDD_RENDER_MINIMAP_H
+#define DDD_RENDER_MINIMAP_H
+
+#include "components/TilemapComponent.h"
+#include "render/RenderSnapshot.h"
+#include "render/TileSources.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// One texel per tile of a tilemap, coloured by tile id (average colour of the tile's region).
+// reset() builds the whole texture once; edits are painted into the CPU copy with paintTile() and
+// sent with one upload() of their bounding rectangle, so a single-tile edit is one texel and a
+// streamed chunk one sub-rectangle, regardless of map size. Drawn into a screen rectangle with
+// player/drop markers on top.
+class Minimap {
+  public:
+    void reset(const TilemapComponent &tilemap, const TileSources &sources);
+    // CPU copy only; the texels reach the GPU with the next upload() covering them.
+    void paintTile(int x, int y, int tileId);
+    void upload(const sf::IntRect &area);
+    void clear();
+    bool isReady() const { return ready; }
+
+    // Fits the map into `frame` (target pixels, default view) keeping its aspect ratio.
+    void draw(sf::RenderTarget &target, const sf::FloatRect &frame, const std::vector<MinimapMarker> &markers) const;
+
+  private:
+    sf::Color colorFor(int tileId) const;
+    static sf::Color averageColor(const sf::Image &image, const sf::IntRect &rect);
+
+    bool ready{false};
+    int width{0};
+    int height{0};
+    int emptyId{-1};
+    sf::Vector2f origin; // world position of the top-left tile corner
+    float tileSize{1.0f};
+    std::vector<sf::Color> palette; // by tile id
+    std::vector<sf::Uint8> pixels;  // RGBA, CPU copy of texture
+    std::vector<sf::Uint8> staging; // contiguous rows of a partial-width upload
+    sf::Texture texture;
+};
+
+#endif // DDD_RENDER_MINIMAP_H
@@ -0,0 +1,157 @@
+#include "render/RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+// Below this many changes (plus a share of the queue) sorted inserts beat a full radix pass.
+constexpr std::size_t kIncrementalBase = 16;
+constexpr std::size_t kIncrementalDivisor = 8;
+} // namespace
+
+std::uint64_t RenderQueue::makeKey(RenderLayer layer, int z, std::uint32_t texId, Entity::Id id) {
+    const int clampedZ = std::clamp(z, -0x8000, 0x7FFF);
+    const std::uint64_t biasedZ = static_cast<std::uint64_t>(clampedZ + 0x8000);
+    return (static_cast<std::uint64_t>(layer) & 0xFu) << 60 | biasedZ << 44 |
+           (static_cast<std::uint64_t>(texId) & 0xFFFFFu) << 24 | (static_cast<std::uint64_t>(id) & 0xFFFFFFu);
+}
+
+std::uint32_t RenderQueue::textureId(const sf::Texture *texture) {
+    auto it = textureIds.find(texture);
+    if (it != textureIds.end())
+        return it->second;
+    const auto id = static_cast<std::uint32_t>(textureIds.size());
+    textureIds.emplace(texture, id);
+    return id;
+}
+
+void RenderQueue::beginFrame() {
+    ++frame;
+    pending.clear();
+}
+
+void RenderQueue::submit(const Item &item, std::uint32_t texId, bool visible) {
+    const std::uint64_t key = makeKey(item.layer, item.z, texId, item.id);
+    auto it = slotById.find(item.id);
+    if (it == slotById.end()) {
+        std::uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        it = slotById.emplace(item.id, index).first;
+        slots[index].live = true;
+        slots[index].key = key;
+        pending.push_back(index);
+    }
+
+    Slot &slot = slots[it->second];
+    if (slot.key != key) {
+        slot.key = key;
+        pending.push_back(it->second);
+    }
+    slot.item = item;
+    slot.seenFrame = frame;
+    if (visible)
+        slot.visibleFrame = frame;
+}
+
+const RenderQueue::Item *RenderQueue::find(Entity::Id id) const {
+    auto it = slotById.find(id);
+    return it != slotById.end() ? &slots[it->second].item : nullptr;
+}
+
+void RenderQueue::markVisible(Entity::Id id) {
+    auto it = slotById.find(id);
+    if (it != slotById.end())
+        slots[it->second].visibleFrame = frame;
+}
+
+void RenderQueue::endFrame() {
+    std::size_t removed = 0;
+    for (std::uint32_t i = 0; i < slots.size(); ++i) {
+        Slot &slot = slots[i];
+        if (!slot.live || slot.seenFrame == frame)
+            continue;
+        slot.live = false;
+        slotById.erase(slot.item.id);
+        slot.item = Item{};
+        ++removed;
+    }
+
+    stats.changes = pending.size() + removed;
+    stats.fullSort = false;
+    if (stats.changes > 0) {
+        const std::size_t live = slotById.size();
+        if (stats.changes > kIncrementalBase + live / kIncrementalDivisor) {
+            order.clear();
+            for (std::uint32_t i = 0; i < slots.size(); ++i) {
+                if (slots[i].live)
+                    order.push_back(OrderEntry{slots[i].key, i});
+            }
+            radixSort();
+            stats.fullSort = true;
+        } else {
+            // Stale entries: dead slots and slots whose key changed this frame.
+            order.erase(std::remove_if(order.begin(), order.end(),
+                                       [this](const OrderEntry &e) {
+                                           const Slot &slot = slots[e.slot];
+                                           return !slot.live || slot.key != e.key;
+                                       }),
+                        order.end());
+            for (std::uint32_t index : pending) {
+                const OrderEntry entry{slots[index].key, index};
+                const auto pos = std::upper_bound(order.begin(), order.end(), entry,
+                                                  [](const OrderEntry &a, const OrderEntry &b) { return a.key < b.key; });
+                order.insert(pos, entry);
+            }
+        }
+    }
+
+    // Slots freed this frame become reusable only now, after their order entries are gone.
+    for (std::uint32_t i = 0; i < slots.size(); ++i) {
+        if (!slots[i].live && slots[i].seenFrame != 0) {
+            slots[i].seenFrame = 0;
+            freeSlots.push_back(i);
+        }
+    }
+    stats.items = order.size();
+}
+
+void RenderQueue::clear() {
+    slots.clear();
+    freeSlots.clear();
+    slotById.clear();
+    order.clear();
+    pending.clear();
+    stats = Stats{};
+}
+
+// LSD radix sort on 8-bit digits; digits that are equal across all keys are skipped.
+void RenderQueue::radixSort() {
+    constexpr int kPasses = 8;
+    std::array<std::array<std::size_t, 256>, kPasses> counts{};
+    for (const OrderEntry &entry : order) {
+        for (int pass = 0; pass < kPasses; ++pass)
+            ++counts[pass][(entry.key >> (pass * 8)) & 0xFFu];
+    }
+
+    scratch.resize(order.size());
+    for (int pass = 0; pass < kPasses; ++pass) {
+        auto &count = counts[pass];
+        if (std::any_of(count.begin(), count.end(), [this](std::size_t c) { return c == order.size(); }))
+            continue;
+        std::size_t offset = 0;
+        for (std::size_t &c : count) {
+            const std::size_t n = c;
+            c = offset;
+            offset += n;
+        }
+        for (const OrderEntry &entry : order)
+            scratch[count[(entry.key >> (pass * 8)) & 0xFFu]++] = entry;
+        order.swap(scratch);
+    }
+}
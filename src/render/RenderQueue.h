@@ -0,0 +1,90 @@
+#ifndef DDD_RENDER_RENDER_QUEUE_H
+#define DDD_RENDER_RENDER_QUEUE_H
+
+#include "components/SpriteComponent.h"
+#include "components/TilemapComponent.h"
+#include "components/TransformComponent.h"
+#include "core/Entity.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Coarse pass; every tilemap draws before every sprite regardless of z.
+enum class RenderLayer : std::uint8_t { Tilemap = 0, Sprite = 1 };
+
+// Persistent draw list ordered by a packed 64-bit key:
+//   [63..60] layer | [59..44] z (biased) | [43..24] texture id | [23..0] entity id (low bits, tie-break)
+// Entries are re-submitted every frame; only new, re-keyed and vanished entries touch the order.
+// A few changes are merged with binary-search inserts, bulk changes fall back to an LSD radix sort.
+class RenderQueue {
+  public:
+    struct Item {
+        Entity::Id id{0};
+        RenderLayer layer{RenderLayer::Sprite};
+        int z{0};
+        const TilemapComponent *tilemap{nullptr};
+        const SpriteComponent *sprite{nullptr};
+        const TransformComponent *transform{nullptr};
+        const sf::Texture *texture{nullptr};
+        sf::IntRect textureRect;
+    };
+
+    struct Stats {
+        std::size_t items{0};
+        std::size_t changes{0};
+        bool fullSort{false};
+    };
+
+    static std::uint64_t makeKey(RenderLayer layer, int z, std::uint32_t textureId, Entity::Id id);
+
+    // Small dense id per texture for key packing; ids are never recycled.
+    std::uint32_t textureId(const sf::Texture *texture);
+
+    void beginFrame();
+    void submit(const Item &item, std::uint32_t texId, bool visible);
+    const Item *find(Entity::Id id) const;
+    void markVisible(Entity::Id id);
+    // Drops entries not submitted this frame and restores key order.
+    void endFrame();
+    void clear();
+
+    // fn(const Item &) in key order for entries marked visible this frame.
+    template <typename Fn> void forEachVisible(Fn &&fn) const {
+        for (const OrderEntry &entry : order) {
+            const Slot &slot = slots[entry.slot];
+            if (slot.visibleFrame == frame)
+                fn(slot.item);
+        }
+    }
+
+    const Stats &getStats() const { return stats; }
+
+  private:
+    struct Slot {
+        Item item;
+        std::uint64_t key{0};
+        std::uint32_t seenFrame{0};
+        std::uint32_t visibleFrame{0};
+        bool live{false};
+    };
+
+    struct OrderEntry {
+        std::uint64_t key{0};
+        std::uint32_t slot{0};
+    };
+
+    void radixSort();
+
+    std::uint32_t frame{0};
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::unordered_map<Entity::Id, std::uint32_t> slotById;
+    std::vector<OrderEntry> order;        // sorted by key
+    std::vector<OrderEntry> scratch;      // radix sort ping-pong buffer
+    std::vector<std::uint32_t> pending;   // slots to (re)insert into order
+    std::unordered_map<const sf::Texture *, std::uint32_t> textureIds;
+    Stats stats;
+};
+
+#endif // DDD_RENDER_RENDER_QUEUE_H
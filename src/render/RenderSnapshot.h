@@ -0,0 +1,140 @@
+#ifndef DDD_RENDER_RENDER_SNAPSHOT_H
+#define DDD_RENDER_RENDER_SNAPSHOT_H
+
+#include "components/TilemapComponent.h"
+#include "core/Entity.h"
+#include "render/TileSources.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Everything the render pass needs for one frame, produced by simulation (RenderSystem/UIRenderSystem::extract)
+// and consumed by render() possibly on another thread. Holds no pointers into ECS state; texture/font pointers
+// are owned by ResourceManager and stay valid for the whole run.
+
+struct MenuRenderButton {
+    std::string id;
+    std::string label;
+    sf::FloatRect rect;
+    bool focused{false};
+};
+
+enum class MenuScreen { Main, MapSelect, Pause, Settings };
+
+struct MenuRenderState {
+    bool visible{false};
+    MenuScreen screen{MenuScreen::Main};
+    std::vector<MenuRenderButton> buttons;
+    std::vector<std::string> maps;
+    int selectedMap{-1};
+    bool hasSave{false};
+    bool canResume{false};
+    bool showMenuButton{false};
+    sf::FloatRect menuButtonRect;
+    bool showDebugButton{false};
+    sf::FloatRect debugButtonRect;
+    std::vector<std::string> settingsLines;
+};
+
+inline bool operator==(const MenuRenderButton &a, const MenuRenderButton &b) {
+    return a.id == b.id && a.label == b.label && a.rect == b.rect && a.focused == b.focused;
+}
+
+inline bool operator==(const MenuRenderState &a, const MenuRenderState &b) {
+    return a.visible == b.visible && a.screen == b.screen && a.buttons == b.buttons && a.maps == b.maps &&
+           a.selectedMap == b.selectedMap && a.hasSave == b.hasSave && a.canResume == b.canResume &&
+           a.showMenuButton == b.showMenuButton && a.menuButtonRect == b.menuButtonRect &&
+           a.showDebugButton == b.showDebugButton && a.debugButtonRect == b.debugButtonRect &&
+           a.settingsLines == b.settingsLines;
+}
+
+inline bool operator!=(const MenuRenderState &a, const MenuRenderState &b) { return !(a == b); }
+
+// World position (world units, y up) of something shown on the minimap.
+struct MinimapMarker {
+    enum class Kind : std::uint8_t { Player, Drop };
+    sf::Vector2f position;
+    Kind kind{Kind::Drop};
+};
+
+struct UISnapshot {
+    struct Slot {
+        int itemId{-1};
+        int count{0};
+        const sf::Texture *iconTexture{nullptr};
+        sf::IntRect iconRect;
+    };
+
+    float dt{0.0f};
+    // Bumped by extract() whenever the state below changes; retained UI layers redraw only then.
+    std::uint64_t menuVersion{0};
+    std::uint64_t inventoryVersion{0};
+    MenuRenderState menu;
+    bool debugVisible{false};
+    std::vector<std::string> debugLines;
+    bool hasInventory{false};
+    int activeIndex{0};
+    std::vector<Slot> slots;
+    std::vector<MinimapMarker> minimapMarkers; // filled by RenderSystem::extract
+};
+
+struct SpriteInstance {
+    const sf::Texture *texture{nullptr};
+    sf::IntRect textureRect;
+    sf::Transform transform; // local quad (0,0)-(|w|,|h|) -> render pixels
+    int z{0};
+};
+
+// Render-side copy of a tilemap plus its resolved tile sources; shared by every snapshot that carries it.
+struct TilemapReset {
+    TilemapComponent tilemap;
+    TileSources sources;
+};
+
+// Tile ids of one chunk as they are now; chunkX/chunkY in TilemapChunkCache::kChunkSize units.
+struct TileChunkPatch {
+    int chunkX{0};
+    int chunkY{0};
+    std::vector<int> tiles; // row-major, clipped to the map; empty when not resident
+    bool resident{true};    // false: the storage chunk around it was streamed out
+};
+
+struct TilemapInstance {
+    Entity::Id id{0};
+    sf::Vector2f renderOrigin; // render pixels of the top-left tile corner
+    sf::Vector2f scale{1.0f, 1.0f};
+    // Set until the render side acknowledged it; patches then carry only the chunks it has not seen yet.
+    std::shared_ptr<const TilemapReset> reset;
+    std::vector<TileChunkPatch> patches;
+};
+
+// Live particles in world units (world y up); alpha already faded by remaining life.
+struct ParticleSnapshot {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> size;
+    std::vector<sf::Color> color;
+
+    std::size_t count() const { return x.size(); }
+    void clear() {
+        x.clear();
+        y.clear();
+        size.clear();
+        color.clear();
+    }
+};
+
+struct RenderSnapshot {
+    std::uint64_t frame{0};
+    sf::View view;
+    sf::FloatRect visibleRect; // render pixels
+    float zoom{1.0f};
+    std::vector<TilemapInstance> tilemaps; // draw order
+    std::vector<SpriteInstance> sprites;   // visible only, draw order
+    ParticleSnapshot particles;            // drawn above sprites
+    UISnapshot ui;
+};
+
+#endif // DDD_RENDER_RENDER_SNAPSHOT_H
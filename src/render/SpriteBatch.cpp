@@ -0,0 +1,54 @@
+#include "render/SpriteBatch.h"
+
+#include <cstdlib>
+
+void SpriteBatch::begin(sf::RenderTarget &renderTarget) {
+    target = &renderTarget;
+    texture = nullptr;
+    vertices.clear();
+    drawCalls = 0;
+    quadCount = 0;
+}
+
+void SpriteBatch::draw(const sf::Texture &tex, const sf::IntRect &rect, const sf::Transform &transform, int z) {
+    if (!target)
+        return;
+    if (!vertices.empty() && (texture != &tex || layer != z))
+        flush();
+    texture = &tex;
+    layer = z;
+
+    const float w = static_cast<float>(std::abs(rect.width));
+    const float h = static_cast<float>(std::abs(rect.height));
+    const float u0 = static_cast<float>(rect.left);
+    const float v0 = static_cast<float>(rect.top);
+    const float u1 = u0 + static_cast<float>(rect.width);
+    const float v1 = v0 + static_cast<float>(rect.height);
+
+    const sf::Vertex tl(transform.transformPoint(0.0f, 0.0f), sf::Vector2f(u0, v0));
+    const sf::Vertex tr(transform.transformPoint(w, 0.0f), sf::Vector2f(u1, v0));
+    const sf::Vertex br(transform.transformPoint(w, h), sf::Vector2f(u1, v1));
+    const sf::Vertex bl(transform.transformPoint(0.0f, h), sf::Vector2f(u0, v1));
+    vertices.push_back(tl);
+    vertices.push_back(tr);
+    vertices.push_back(br);
+    vertices.push_back(tl);
+    vertices.push_back(br);
+    vertices.push_back(bl);
+    ++quadCount;
+}
+
+void SpriteBatch::end() {
+    flush();
+    target = nullptr;
+}
+
+void SpriteBatch::flush() {
+    if (!target || vertices.empty())
+        return;
+    sf::RenderStates states;
+    states.texture = texture;
+    target->draw(vertices.data(), vertices.size(), sf::Triangles, states);
+    vertices.clear();
+    ++drawCalls;
+}
@@ -0,0 +1,30 @@
+#ifndef DDD_RENDER_SPRITE_BATCH_H
+#define DDD_RENDER_SPRITE_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Collects textured quads into one vertex buffer and draws them with a single call per run of
+// (texture, layer). Submission order is kept, so callers stay responsible for sorting.
+class SpriteBatch {
+  public:
+    void begin(sf::RenderTarget &renderTarget);
+    // `rect` is the texture rect; the quad spans (0,0)-(|w|,|h|) in local space before `transform`, like sf::Sprite.
+    void draw(const sf::Texture &texture, const sf::IntRect &rect, const sf::Transform &transform, int layer);
+    void end();
+    // Submits pending quads now, e.g. before drawing something that bypasses the batch.
+    void flush();
+
+    int getDrawCalls() const { return drawCalls; }
+    int getQuadCount() const { return quadCount; }
+
+  private:
+    sf::RenderTarget *target{nullptr};
+    const sf::Texture *texture{nullptr};
+    int layer{0};
+    std::vector<sf::Vertex> vertices; // reused between frames
+    int drawCalls{0};
+    int quadCount{0};
+};
+
+#endif // DDD_RENDER_SPRITE_BATCH_H
@@ -0,0 +1,176 @@
+#include "render/TextCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+std::size_t TextCache::KeyHash::operator()(const Key &k) const {
+    std::size_t h = std::hash<std::string>{}(k.text);
+    std::uint32_t outlineBits = 0;
+    std::memcpy(&outlineBits, &k.outlineThickness, sizeof(outlineBits));
+    const std::size_t extra[] = {std::hash<const void *>{}(k.font), k.characterSize, outlineBits};
+    for (std::size_t v : extra)
+        h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+const TextLayout &TextCache::layout(const sf::Font &font, unsigned characterSize, const std::string &text,
+                                    float outlineThickness) {
+    probe.font = &font;
+    probe.characterSize = characterSize;
+    probe.outlineThickness = outlineThickness;
+    probe.text.assign(text);
+
+    auto it = entries.find(probe);
+    if (it == entries.end()) {
+        it = entries.emplace(probe, Entry{}).first;
+        build(font, characterSize, text, outlineThickness, it->second.layout);
+    }
+    it->second.lastUsed = frame;
+    return it->second.layout;
+}
+
+void TextCache::endFrame() {
+    ++frame;
+    if (frame % kMaxIdleFrames != 0)
+        return;
+    for (auto it = entries.begin(); it != entries.end();)
+        it = (frame - it->second.lastUsed > kMaxIdleFrames) ? entries.erase(it) : std::next(it);
+}
+
+namespace {
+
+// Same quad as sf::Text (1px padding around the glyph, outline glyphs shifted by the thickness).
+void addGlyphQuad(std::vector<sf::Vertex> &out, float x, float y, const sf::Glyph &glyph, float outlineThickness) {
+    const float padding = 1.0f;
+    const float left = x + glyph.bounds.left - padding - outlineThickness;
+    const float top = y + glyph.bounds.top - padding - outlineThickness;
+    const float right = x + glyph.bounds.left + glyph.bounds.width + padding - outlineThickness;
+    const float bottom = y + glyph.bounds.top + glyph.bounds.height + padding - outlineThickness;
+
+    const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+    const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+    const float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+    const float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+    const sf::Color white = sf::Color::White;
+    out.emplace_back(sf::Vector2f(left, top), white, sf::Vector2f(u1, v1));
+    out.emplace_back(sf::Vector2f(right, top), white, sf::Vector2f(u2, v1));
+    out.emplace_back(sf::Vector2f(left, bottom), white, sf::Vector2f(u1, v2));
+    out.emplace_back(sf::Vector2f(left, bottom), white, sf::Vector2f(u1, v2));
+    out.emplace_back(sf::Vector2f(right, top), white, sf::Vector2f(u2, v1));
+    out.emplace_back(sf::Vector2f(right, bottom), white, sf::Vector2f(u2, v2));
+}
+
+} // namespace
+
+void TextCache::build(const sf::Font &font, unsigned characterSize, const std::string &text, float outlineThickness,
+                      TextLayout &out) {
+    out.page = &font.getTexture(characterSize);
+    out.fill.clear();
+    out.outline.clear();
+    out.fill.reserve(text.size() * 6);
+    if (outlineThickness != 0.0f)
+        out.outline.reserve(text.size() * 6);
+
+    const float whitespaceWidth = font.getGlyph(U' ', characterSize, false).advance;
+    const float lineSpacing = font.getLineSpacing(characterSize);
+    float x = 0.0f;
+    float y = static_cast<float>(characterSize);
+    float minX = static_cast<float>(characterSize);
+    float minY = static_cast<float>(characterSize);
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    sf::Uint32 prevChar = 0;
+
+    for (const char c : text) {
+        const sf::Uint32 curChar = static_cast<unsigned char>(c);
+        x += font.getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        if (curChar == U' ' || curChar == U'\n' || curChar == U'\t') {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            if (curChar == U' ') {
+                x += whitespaceWidth;
+            } else if (curChar == U'\t') {
+                x += whitespaceWidth * 4.0f;
+            } else {
+                y += lineSpacing;
+                x = 0.0f;
+            }
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        if (outlineThickness != 0.0f)
+            addGlyphQuad(out.outline, x, y, font.getGlyph(curChar, characterSize, false, outlineThickness),
+                         outlineThickness);
+
+        const sf::Glyph &glyph = font.getGlyph(curChar, characterSize, false);
+        addGlyphQuad(out.fill, x, y, glyph, 0.0f);
+        minX = std::min(minX, x + glyph.bounds.left);
+        maxX = std::max(maxX, x + glyph.bounds.left + glyph.bounds.width);
+        minY = std::min(minY, y + glyph.bounds.top);
+        maxY = std::max(maxY, y + glyph.bounds.top + glyph.bounds.height);
+        x += glyph.advance;
+    }
+
+    if (text.empty())
+        minX = minY = 0.0f;
+    if (outlineThickness != 0.0f) {
+        const float t = std::abs(outlineThickness);
+        minX -= t;
+        maxX += t;
+        minY -= t;
+        maxY += t;
+    }
+    out.bounds = sf::FloatRect(minX, minY, std::max(0.0f, maxX - minX), std::max(0.0f, maxY - minY));
+}
+
+void TextBatch::append(std::vector<sf::Vertex> &dst, const std::vector<sf::Vertex> &src, sf::Vector2f offset,
+                       sf::Color color) {
+    const std::size_t base = dst.size();
+    dst.insert(dst.end(), src.begin(), src.end());
+    for (std::size_t i = base; i < dst.size(); ++i) {
+        dst[i].position += offset;
+        dst[i].color = color;
+    }
+}
+
+void TextBatch::add(const TextLayout &layout, sf::Vector2f position, sf::Color fillColor, sf::Color outlineColor) {
+    if (!layout.page || layout.fill.empty())
+        return;
+    // Rounded like sf::Text drawn at integer positions, which keeps glyphs crisp.
+    position.x = std::round(position.x);
+    position.y = std::round(position.y);
+
+    auto it = std::find_if(pages.begin(), pages.end(), [&](const Page &p) { return p.texture == layout.page; });
+    if (it == pages.end()) {
+        pages.push_back(Page{layout.page, {}, {}});
+        it = pages.end() - 1;
+    }
+    append(it->outline, layout.outline, position, outlineColor);
+    append(it->fill, layout.fill, position, fillColor);
+}
+
+void TextBatch::draw(sf::RenderTarget &target, const sf::RenderStates &states) {
+    for (const Page &page : pages) {
+        sf::RenderStates pageStates = states;
+        pageStates.texture = page.texture;
+        if (!page.outline.empty())
+            target.draw(page.outline.data(), page.outline.size(), sf::Triangles, pageStates);
+        if (!page.fill.empty())
+            target.draw(page.fill.data(), page.fill.size(), sf::Triangles, pageStates);
+    }
+}
+
+void TextBatch::clear() {
+    // Keeps page vectors (and their capacity) for the next frame.
+    for (Page &page : pages) {
+        page.outline.clear();
+        page.fill.clear();
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef DDD_RENDER_TEXT_CACHE_H
+#define DDD_RENDER_TEXT_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Glyph quads of a laid-out string, in the same local space as sf::Text (origin at the top-left of the
+// first line, baseline at characterSize). Texture coordinates point into font.getTexture(characterSize).
+struct TextLayout {
+    const sf::Texture *page{nullptr};
+    std::vector<sf::Vertex> fill;    // 6 vertices per visible glyph, white
+    std::vector<sf::Vertex> outline; // empty without outline
+    sf::FloatRect bounds;            // like sf::Text::getLocalBounds()
+};
+
+// Layouts keyed by (font, size, outline, string); a lookup hashes the string instead of re-running glyph
+// layout. Entries not used for kMaxIdleFrames frames are evicted by endFrame().
+class TextCache {
+  public:
+    static constexpr std::uint64_t kMaxIdleFrames = 120;
+
+    const TextLayout &layout(const sf::Font &font, unsigned characterSize, const std::string &text,
+                             float outlineThickness = 0.0f);
+    void endFrame();
+
+    std::size_t size() const { return entries.size(); }
+
+  private:
+    struct Key {
+        const sf::Font *font{nullptr};
+        unsigned characterSize{0};
+        float outlineThickness{0.0f};
+        std::string text;
+        bool operator==(const Key &o) const {
+            return font == o.font && characterSize == o.characterSize && outlineThickness == o.outlineThickness &&
+                   text == o.text;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key &k) const;
+    };
+    struct Entry {
+        TextLayout layout;
+        std::uint64_t lastUsed{0};
+    };
+
+    static void build(const sf::Font &font, unsigned characterSize, const std::string &text, float outlineThickness,
+                      TextLayout &out);
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    Key probe; // reused lookup key, avoids a string allocation per hit
+    std::uint64_t frame{0};
+};
+
+// Accumulates cached layouts into one vertex array per font page and draws each with a single call.
+// Within a page all outlines are drawn before all fills, so overlapping outlined texts may differ from sf::Text.
+class TextBatch {
+  public:
+    void add(const TextLayout &layout, sf::Vector2f position, sf::Color fillColor,
+             sf::Color outlineColor = sf::Color::Black);
+    void draw(sf::RenderTarget &target, const sf::RenderStates &states = sf::RenderStates::Default);
+    void clear();
+
+  private:
+    struct Page {
+        const sf::Texture *texture{nullptr};
+        std::vector<sf::Vertex> outline;
+        std::vector<sf::Vertex> fill;
+    };
+
+    static void append(std::vector<sf::Vertex> &dst, const std::vector<sf::Vertex> &src, sf::Vector2f offset,
+                       sf::Color color);
+
+    std::vector<Page> pages; // few pages per frame; linear search
+};
+
+#endif // DDD_RENDER_TEXT_CACHE_H
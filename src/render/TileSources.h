@@ -0,0 +1,46 @@
+#ifndef DDD_RENDER_TILE_SOURCES_H
+#define DDD_RENDER_TILE_SOURCES_H
+
+#include "components/TilemapComponent.h"
+#include "managers/ResourceManager.h"
+#include <SFML/Graphics.hpp>
+#include <span>
+#include <vector>
+
+// Texture + rect of every tile id of one tilemap, resolved up front on the simulation thread.
+// Tile renderers read this instead of ResourceManager, whose handle tables may grow while they draw.
+class TileSources {
+  public:
+    struct Source {
+        const sf::Texture *texture{nullptr};
+        sf::IntRect rect;
+    };
+
+    static TileSources resolve(const TilemapComponent &tilemap, const ResourceManager &resources) {
+        TileSources out;
+        const std::span<const TileProperties> tiles = tilemap.registry.all();
+        out.byTileId.resize(tiles.size());
+        for (std::size_t id = 0; id < tiles.size(); ++id) {
+            const ResourceManager::AtlasRegion *region = resources.region(tiles[id].region);
+            if (!region)
+                continue;
+            out.byTileId[id].texture = resources.texture(region->texture);
+            out.byTileId[id].rect = region->rect;
+        }
+        return out;
+    }
+
+    // nullptr for empty / unknown ids and for regions whose texture is not loaded.
+    const Source *find(int tileId) const {
+        if (tileId < 0 || tileId >= static_cast<int>(byTileId.size()) || !byTileId[tileId].texture)
+            return nullptr;
+        return &byTileId[tileId];
+    }
+
+    int size() const { return static_cast<int>(byTileId.size()); }
+
+  private:
+    std::vector<Source> byTileId;
+};
+
+#endif // DDD_RENDER_TILE_SOURCES_H
@@ -0,0 +1,256 @@
+#include "render/TilemapChunkCache.h"
+
+#include "utils/Constants.h"
+#include <algorithm>
+#include <cmath>
+
+void TilemapChunkCache::markDirty(int tileX, int tileY) {
+    if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height)
+        return;
+    const int chunkX = tileX / kChunkSize;
+    const int chunkY = tileY / kChunkSize;
+    Chunk &chunk = chunks[chunkY * chunksX + chunkX];
+    if (chunk.dirty)
+        return; // imposters rebuild their dirty chunks, so any built since already saw this one
+    chunk.dirty = true;
+    if (imposters.empty())
+        return;
+    for (int lod = 1; lod <= kMaxLod; ++lod) {
+        auto it = imposters.find(imposterKey(lod, chunkX >> lod, chunkY >> lod));
+        if (it != imposters.end() && !it->second.dirty)
+            it->second.dirtyChunks.push_back(chunkY * chunksX + chunkX);
+    }
+}
+
+void TilemapChunkCache::markAllDirty() {
+    for (auto &chunk : chunks)
+        chunk.dirty = true;
+    for (auto &entry : imposters) {
+        entry.second.dirty = true;
+        entry.second.dirtyChunks.clear();
+    }
+}
+
+void TilemapChunkCache::ensureLayout(const TilemapComponent &tilemap) {
+    if (tilemap.width == width && tilemap.height == height && tilemap.tileSize == tileSize)
+        return;
+    width = tilemap.width;
+    height = tilemap.height;
+    tileSize = tilemap.tileSize;
+    chunksX = (width + kChunkSize - 1) / kChunkSize;
+    chunksY = (height + kChunkSize - 1) / kChunkSize;
+    chunks.clear();
+    chunks.resize(static_cast<std::size_t>(chunksX * chunksY));
+    imposters.clear();
+}
+
+void TilemapChunkCache::rebuildChunk(const TilemapComponent &tilemap, const TileSources &sources, int chunkX,
+                                     int chunkY, Chunk &chunk) {
+    for (auto &layer : chunk.layers)
+        layer.vertices.clear();
+
+    const float px = tilemap.tileSize * RENDER_SCALE;
+    const int x0 = chunkX * kChunkSize;
+    const int y0 = chunkY * kChunkSize;
+    const int x1 = std::min(x0 + kChunkSize, tilemap.width);
+    const int y1 = std::min(y0 + kChunkSize, tilemap.height);
+
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const TileSources::Source *region = sources.find(tilemap.get(x, y));
+            if (!region)
+                continue;
+            const sf::Texture *texture = region->texture;
+
+            auto layerIt = std::find_if(chunk.layers.begin(), chunk.layers.end(),
+                                        [&](const Layer &l) { return l.texture == texture; });
+            if (layerIt == chunk.layers.end()) {
+                chunk.layers.push_back(Layer{texture, sf::VertexArray(sf::Triangles)});
+                layerIt = chunk.layers.end() - 1;
+            }
+
+            const float left = static_cast<float>(x) * px;
+            const float top = static_cast<float>(y) * px;
+            const float u0 = static_cast<float>(region->rect.left);
+            const float v0 = static_cast<float>(region->rect.top);
+            const float u1 = u0 + static_cast<float>(region->rect.width);
+            const float v1 = v0 + static_cast<float>(region->rect.height);
+
+            const sf::Vertex tl({left, top}, {u0, v0});
+            const sf::Vertex tr({left + px, top}, {u1, v0});
+            const sf::Vertex br({left + px, top + px}, {u1, v1});
+            const sf::Vertex bl({left, top + px}, {u0, v1});
+            sf::VertexArray &va = layerIt->vertices;
+            va.append(tl);
+            va.append(tr);
+            va.append(br);
+            va.append(tl);
+            va.append(br);
+            va.append(bl);
+        }
+    }
+
+    // Textures no longer referenced by this chunk.
+    chunk.layers.erase(std::remove_if(chunk.layers.begin(), chunk.layers.end(),
+                                      [](const Layer &l) { return l.vertices.getVertexCount() == 0; }),
+                       chunk.layers.end());
+    chunk.dirty = false;
+}
+
+void TilemapChunkCache::drawChunkInto(const TilemapComponent &tilemap, const TileSources &sources, int chunkX,
+                                      int chunkY, sf::RenderTarget &target, const sf::RenderStates &states,
+                                      int &drawCalls) {
+    Chunk &chunk = chunks[chunkY * chunksX + chunkX];
+    if (chunk.dirty)
+        rebuildChunk(tilemap, sources, chunkX, chunkY, chunk);
+    for (const auto &layer : chunk.layers) {
+        sf::RenderStates layerStates = states;
+        layerStates.texture = layer.texture;
+        target.draw(layer.vertices, layerStates);
+        ++drawCalls;
+    }
+}
+
+bool TilemapChunkCache::updateImposter(const TilemapComponent &tilemap, const TileSources &sources,
+                                       Imposter &imposter, int regionX, int regionY, float chunkPx, int lod) {
+    int unused = 0;
+    if (!imposter.dirty && !imposter.texture && !imposter.dirtyChunks.empty())
+        imposter.dirty = true; // had no tiles so far; render from scratch
+    if (!imposter.dirty) {
+        // Edits redraw only the chunks they touched: cleared to transparent, then drawn again.
+        if (!imposter.dirtyChunks.empty()) {
+            sf::RenderTexture &rt = *imposter.texture;
+            for (int index : imposter.dirtyChunks) {
+                const int cx = index % chunksX;
+                const int cy = index / chunksX;
+                const float left = static_cast<float>(cx) * chunkPx;
+                const float top = static_cast<float>(cy) * chunkPx;
+                const sf::Vertex clearQuad[] = {
+                    sf::Vertex({left, top}, sf::Color::Transparent),
+                    sf::Vertex({left + chunkPx, top}, sf::Color::Transparent),
+                    sf::Vertex({left, top + chunkPx}, sf::Color::Transparent),
+                    sf::Vertex({left + chunkPx, top + chunkPx}, sf::Color::Transparent),
+                };
+                rt.draw(clearQuad, 4, sf::TriangleStrip, sf::RenderStates(sf::BlendNone));
+                drawChunkInto(tilemap, sources, cx, cy, rt, sf::RenderStates::Default, unused);
+            }
+            rt.display();
+            imposter.dirtyChunks.clear();
+        }
+        return imposter.texture != nullptr;
+    }
+    imposter.dirtyChunks.clear();
+
+    const int side = 1 << lod;
+    const int cx0 = regionX * side;
+    const int cy0 = regionY * side;
+    const int cx1 = std::min(cx0 + side, chunksX);
+    const int cy1 = std::min(cy0 + side, chunksY);
+    bool anyTiles = false;
+    for (int cy = cy0; cy < cy1; ++cy) {
+        for (int cx = cx0; cx < cx1; ++cx) {
+            Chunk &chunk = chunks[cy * chunksX + cx];
+            if (chunk.dirty)
+                rebuildChunk(tilemap, sources, cx, cy, chunk);
+            anyTiles = anyTiles || !chunk.layers.empty();
+        }
+    }
+    if (!anyTiles) {
+        imposter.texture.reset();
+        imposter.dirty = false;
+        return false;
+    }
+
+    if (!imposter.texture) {
+        // Region side (2^lod chunks) at 1/2^lod resolution: one chunk's worth of texels at every level.
+        const unsigned size = std::max(1u, static_cast<unsigned>(chunkPx));
+        auto texture = std::make_unique<sf::RenderTexture>();
+        if (!texture->create(size, size))
+            return false; // stays dirty; the caller draws the chunks directly
+        texture->setSmooth(true);
+        imposter.texture = std::move(texture);
+    }
+
+    sf::RenderTexture &rt = *imposter.texture;
+    const float regionPx = chunkPx * static_cast<float>(side);
+    rt.clear(sf::Color::Transparent);
+    rt.setView(sf::View(sf::FloatRect(static_cast<float>(cx0) * chunkPx, static_cast<float>(cy0) * chunkPx,
+                                      regionPx, regionPx)));
+    for (int cy = cy0; cy < cy1; ++cy) {
+        for (int cx = cx0; cx < cx1; ++cx)
+            drawChunkInto(tilemap, sources, cx, cy, rt, sf::RenderStates::Default, unused);
+    }
+    rt.display();
+    imposter.dirty = false;
+    return true;
+}
+
+void TilemapChunkCache::evictImposters() {
+    for (auto it = imposters.begin(); it != imposters.end();) {
+        if (frame - it->second.lastUsed > kImposterTtlFrames)
+            it = imposters.erase(it);
+        else
+            ++it;
+    }
+}
+
+int TilemapChunkCache::draw(const TilemapComponent &tilemap, const TileSources &sources, sf::RenderTarget &target,
+                            const sf::RenderStates &states, const sf::FloatRect &visible, int lod) {
+    ensureLayout(tilemap);
+    lod = std::clamp(lod, 0, kMaxLod);
+    ++frame;
+    evictImposters();
+    if (chunks.empty())
+        return 0;
+
+    const float chunkPx = tilemap.tileSize * RENDER_SCALE * static_cast<float>(kChunkSize);
+    if (chunkPx <= 0.0f)
+        return 0;
+    const auto chunkIndex = [chunkPx](float px) { return static_cast<int>(std::floor(px / chunkPx)); };
+    const int cx0 = std::max(0, chunkIndex(visible.left));
+    const int cy0 = std::max(0, chunkIndex(visible.top));
+    const int cx1 = std::min(chunksX - 1, chunkIndex(visible.left + visible.width));
+    const int cy1 = std::min(chunksY - 1, chunkIndex(visible.top + visible.height));
+
+    int drawCalls = 0;
+    if (lod > 0) {
+        const float regionPx = chunkPx * static_cast<float>(1 << lod);
+        for (int ry = cy0 >> lod; ry <= cy1 >> lod; ++ry) {
+            for (int rx = cx0 >> lod; rx <= cx1 >> lod; ++rx) {
+                Imposter &imposter = imposters[imposterKey(lod, rx, ry)];
+                imposter.lastUsed = frame;
+                if (!updateImposter(tilemap, sources, imposter, rx, ry, chunkPx, lod)) {
+                    if (!imposter.dirty)
+                        continue; // no tiles in this region
+                    // No render texture available: draw the visible part of the region chunk by chunk.
+                    const int side = 1 << lod;
+                    for (int cy = std::max(cy0, ry * side); cy <= std::min(cy1, ry * side + side - 1); ++cy) {
+                        for (int cx = std::max(cx0, rx * side); cx <= std::min(cx1, rx * side + side - 1); ++cx)
+                            drawChunkInto(tilemap, sources, cx, cy, target, states, drawCalls);
+                    }
+                    continue;
+                }
+                const float left = static_cast<float>(rx) * regionPx;
+                const float top = static_cast<float>(ry) * regionPx;
+                const float texSize = static_cast<float>(imposter.texture->getSize().x);
+                const sf::Vertex quad[] = {
+                    sf::Vertex({left, top}, {0.0f, 0.0f}),
+                    sf::Vertex({left + regionPx, top}, {texSize, 0.0f}),
+                    sf::Vertex({left, top + regionPx}, {0.0f, texSize}),
+                    sf::Vertex({left + regionPx, top + regionPx}, {texSize, texSize}),
+                };
+                sf::RenderStates imposterStates = states;
+                imposterStates.texture = &imposter.texture->getTexture();
+                target.draw(quad, 4, sf::TriangleStrip, imposterStates);
+                ++drawCalls;
+            }
+        }
+        return drawCalls;
+    }
+
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx)
+            drawChunkInto(tilemap, sources, cx, cy, target, states, drawCalls);
+    }
+    return drawCalls;
+}
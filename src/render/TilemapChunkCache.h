@@ -0,0 +1,75 @@
+#ifndef DDD_RENDER_TILEMAP_CHUNK_CACHE_H
+#define DDD_RENDER_TILEMAP_CHUNK_CACHE_H
+
+#include "components/TilemapComponent.h"
+#include "render/TileSources.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Baked tile geometry for one tilemap, split into kChunkSize x kChunkSize chunks.
+// Vertices are in tilemap-local render pixels (top-left tile at 0,0); the caller supplies the transform.
+// A chunk is rebuilt only after markDirty() touches it, then drawn with one call per texture it uses.
+// When zoomed out (lod > 0) the map is instead drawn from prerendered region imposters: at lod n one imposter
+// covers 2^n x 2^n chunks at 1/2^n resolution, so every imposter has the texel size of one chunk and the number
+// drawn stays the same however far the view zooms out. An imposter is re-rendered only after one of its chunks
+// changes, and freed once it has not been drawn for kImposterTtlFrames draws.
+class TilemapChunkCache {
+  public:
+    static constexpr int kChunkSize = 16;
+    static constexpr int kMaxLod = 8; // a 256x256-chunk region per imposter, the whole generated map
+    static constexpr std::uint64_t kImposterTtlFrames = 120;
+
+    void markDirty(int tileX, int tileY);
+    void markAllDirty();
+
+    // Draws the chunks overlapping `visible` (tilemap-local render pixels), rebuilding the dirty ones first.
+    // Chunks outside the view stay dirty until they scroll in. Returns the number of draw calls issued.
+    int draw(const TilemapComponent &tilemap, const TileSources &sources, sf::RenderTarget &target,
+             const sf::RenderStates &states, const sf::FloatRect &visible, int lod = 0);
+
+  private:
+    struct Layer {
+        const sf::Texture *texture{nullptr};
+        sf::VertexArray vertices{sf::Triangles};
+    };
+
+    struct Chunk {
+        std::vector<Layer> layers;
+        bool dirty{true};
+    };
+
+    struct Imposter {
+        std::unique_ptr<sf::RenderTexture> texture; // null once rendered for a region without tiles
+        bool dirty{true};                           // whole region
+        std::vector<int> dirtyChunks;               // chunk indices to redraw in place
+        std::uint64_t lastUsed{0};
+    };
+
+    static std::uint64_t imposterKey(int lod, int regionX, int regionY) {
+        return (static_cast<std::uint64_t>(lod) << 56) | (static_cast<std::uint64_t>(regionX) << 28) |
+               static_cast<std::uint64_t>(regionY);
+    }
+
+    void ensureLayout(const TilemapComponent &tilemap);
+    void rebuildChunk(const TilemapComponent &tilemap, const TileSources &sources, int chunkX, int chunkY,
+                      Chunk &chunk);
+    bool updateImposter(const TilemapComponent &tilemap, const TileSources &sources, Imposter &imposter,
+                        int regionX, int regionY, float chunkPx, int lod);
+    void drawChunkInto(const TilemapComponent &tilemap, const TileSources &sources, int chunkX, int chunkY,
+                       sf::RenderTarget &target, const sf::RenderStates &states, int &drawCalls);
+    void evictImposters();
+
+    int width{0};
+    int height{0};
+    float tileSize{0.0f};
+    int chunksX{0};
+    int chunksY{0};
+    std::vector<Chunk> chunks;
+    std::unordered_map<std::uint64_t, Imposter> imposters; // by imposterKey
+    std::uint64_t frame{0};
+};
+
+#endif // DDD_RENDER_TILEMAP_CHUNK_CACHE_H
@@ -0,0 +1,192 @@
+#include "render/TilemapShaderRenderer.h"
+
+#include "utils/Constants.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+const char *kVertexSource = R"(
+void main() {
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    gl_TexCoord[0] = gl_MultiTexCoord0;
+    gl_FrontColor = gl_Color;
+}
+)";
+
+// Texture coordinate = tilemap-local render pixels.
+const char *kFragmentSource = R"(
+uniform sampler2D tileIds;
+uniform sampler2D regions;
+uniform sampler2D atlas;
+uniform vec2 mapSize;
+uniform float regionCount;
+uniform vec2 atlasSize;
+uniform vec2 regionSize;
+uniform float tilePx;
+
+float decode16(float lo, float hi) {
+    return floor(lo * 255.0 + 0.5) + floor(hi * 255.0 + 0.5) * 256.0;
+}
+
+void main() {
+    vec2 local = gl_TexCoord[0].xy / tilePx;
+    vec2 tile = floor(local);
+    vec4 idTexel = texture2D(tileIds, (tile + 0.5) / mapSize);
+    if (idTexel.a < 0.5)
+        discard;
+    float id = decode16(idTexel.r, idTexel.g);
+    vec4 region = texture2D(regions, vec2((id + 0.5) / regionCount, 0.5));
+    vec2 origin = vec2(decode16(region.r, region.g), decode16(region.b, region.a));
+    vec2 texel = origin + min(floor(fract(local) * regionSize), regionSize - 1.0) + 0.5;
+    gl_FragColor = texture2D(atlas, texel / atlasSize) * gl_Color;
+}
+)";
+
+// One program shared by all tilemaps; compiled on first use.
+sf::Shader *sharedShader() {
+    static std::unique_ptr<sf::Shader> shader;
+    static bool attempted = false;
+    if (!attempted) {
+        attempted = true;
+        if (sf::Shader::isAvailable()) {
+            auto candidate = std::make_unique<sf::Shader>();
+            if (candidate->loadFromMemory(kVertexSource, kFragmentSource))
+                shader = std::move(candidate);
+            else
+                std::cerr << "Tilemap shader failed to compile, using chunked tile rendering\n";
+        }
+    }
+    return shader.get();
+}
+
+void put16(sf::Uint8 *dst, int value) {
+    dst[0] = static_cast<sf::Uint8>(value & 0xFF);
+    dst[1] = static_cast<sf::Uint8>((value >> 8) & 0xFF);
+}
+
+} // namespace
+
+bool TilemapShaderRenderer::isAvailable() { return sharedShader() != nullptr; }
+
+void TilemapShaderRenderer::markDirty(int tileX, int tileY) {
+    if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height)
+        return;
+    dirtyTiles.push_back({tileX, tileY});
+}
+
+void TilemapShaderRenderer::encodeTile(const TilemapComponent &tilemap, const TileSources &sources, int x, int y,
+                                       sf::Uint8 *texel) const {
+    const int tileId = tilemap.get(x, y);
+    const TileSources::Source *region = sources.find(tileId);
+    const bool drawable = region && region->texture == atlas;
+    put16(texel, drawable ? tileId : 0);
+    texel[2] = 0;
+    texel[3] = drawable ? 255 : 0;
+}
+
+bool TilemapShaderRenderer::rebuild(const TilemapComponent &tilemap, const TileSources &sources) {
+    needsRebuild = false;
+    dirtyTiles.clear();
+    eligible = false;
+    width = tilemap.width;
+    height = tilemap.height;
+
+    const unsigned maxSize = sf::Texture::getMaximumSize();
+    const int regionCount = std::max(1, sources.size());
+    if (width <= 0 || height <= 0 || static_cast<unsigned>(std::max(width, height)) > maxSize ||
+        static_cast<unsigned>(regionCount) > maxSize || regionCount > 0x10000)
+        return false;
+
+    // All regions must share one texture and size; the table stores their top-left corners.
+    atlas = nullptr;
+    std::vector<sf::Uint8> table(static_cast<std::size_t>(regionCount) * 4, 0);
+    for (int id = 0; id < sources.size(); ++id) {
+        const TileSources::Source *region = sources.find(id);
+        if (!region)
+            continue;
+        const sf::Texture *tex = region->texture;
+        const sf::Vector2i size{region->rect.width, region->rect.height};
+        if (!atlas) {
+            atlas = tex;
+            regionSize = size;
+        } else if (tex != atlas || size != regionSize) {
+            return false;
+        }
+        put16(&table[static_cast<std::size_t>(id) * 4], region->rect.left);
+        put16(&table[static_cast<std::size_t>(id) * 4 + 2], region->rect.top);
+    }
+    if (!atlas || regionSize.x <= 0 || regionSize.y <= 0)
+        return false;
+
+    texels.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x)
+            encodeTile(tilemap, sources, x, y, &texels[(static_cast<std::size_t>(y) * width + x) * 4]);
+    }
+
+    if (!idTexture.create(static_cast<unsigned>(width), static_cast<unsigned>(height)) ||
+        !regionTable.create(static_cast<unsigned>(regionCount), 1))
+        return false;
+    idTexture.setSmooth(false);
+    regionTable.setSmooth(false);
+    idTexture.update(texels.data());
+    regionTable.update(table.data());
+    eligible = true;
+    return true;
+}
+
+void TilemapShaderRenderer::flushDirty(const TilemapComponent &tilemap, const TileSources &sources) {
+    for (const sf::Vector2i &tile : dirtyTiles) {
+        sf::Uint8 *texel = &texels[(static_cast<std::size_t>(tile.y) * width + tile.x) * 4];
+        encodeTile(tilemap, sources, tile.x, tile.y, texel);
+        idTexture.update(texel, 1, 1, static_cast<unsigned>(tile.x), static_cast<unsigned>(tile.y));
+    }
+    dirtyTiles.clear();
+}
+
+bool TilemapShaderRenderer::draw(const TilemapComponent &tilemap, const TileSources &sources,
+                                 sf::RenderTarget &target, const sf::RenderStates &states,
+                                 const sf::FloatRect &visible) {
+    sf::Shader *shader = sharedShader();
+    if (!shader)
+        return false;
+    if (needsRebuild || tilemap.width != width || tilemap.height != height)
+        rebuild(tilemap, sources);
+    if (!eligible)
+        return false;
+    flushDirty(tilemap, sources);
+
+    // Quad over the visible part of the map only; texture coordinates carry local pixels to the shader.
+    const float px = tilemap.tileSize * RENDER_SCALE;
+    const float left = std::max(0.0f, visible.left);
+    const float top = std::max(0.0f, visible.top);
+    const float right = std::min(static_cast<float>(width) * px, visible.left + visible.width);
+    const float bottom = std::min(static_cast<float>(height) * px, visible.top + visible.height);
+    if (right <= left || bottom <= top)
+        return true;
+
+    const sf::Vector2u atlasSize = atlas->getSize();
+    shader->setUniform("tileIds", idTexture);
+    shader->setUniform("regions", regionTable);
+    shader->setUniform("atlas", *atlas);
+    shader->setUniform("mapSize", sf::Glsl::Vec2(static_cast<float>(width), static_cast<float>(height)));
+    shader->setUniform("regionCount", static_cast<float>(regionTable.getSize().x));
+    shader->setUniform("atlasSize", sf::Glsl::Vec2(static_cast<float>(atlasSize.x), static_cast<float>(atlasSize.y)));
+    shader->setUniform("regionSize",
+                       sf::Glsl::Vec2(static_cast<float>(regionSize.x), static_cast<float>(regionSize.y)));
+    shader->setUniform("tilePx", px);
+
+    const sf::Vertex quad[] = {
+        sf::Vertex({left, top}, {left, top}),
+        sf::Vertex({right, top}, {right, top}),
+        sf::Vertex({left, bottom}, {left, bottom}),
+        sf::Vertex({right, bottom}, {right, bottom}),
+    };
+    sf::RenderStates quadStates = states;
+    quadStates.texture = nullptr;
+    quadStates.shader = shader;
+    target.draw(quad, 4, sf::TriangleStrip, quadStates);
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef DDD_RENDER_TILEMAP_SHADER_RENDERER_H
+#define DDD_RENDER_TILEMAP_SHADER_RENDERER_H
+
+#include "components/TilemapComponent.h"
+#include "render/TileSources.h"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Draws a whole tilemap as one quad: tile ids live in a width x height RGBA8 texture (id in RG, A = drawable),
+// a 1-row table maps tile id -> region origin, and a fragment shader samples the atlas per pixel.
+// Requires every drawable tile region to sit on the same texture with the same size; draw() returns false
+// otherwise (or when shaders are unavailable) so the caller can fall back to TilemapChunkCache.
+// Sticks to GLSL 1.10 / RGBA8 so it runs on software GL (Mesa llvmpipe).
+class TilemapShaderRenderer {
+  public:
+    static bool isAvailable();
+
+    void markDirty(int tileX, int tileY);
+    void markAllDirty() { needsRebuild = true; }
+
+    // Same coordinate convention as TilemapChunkCache::draw.
+    bool draw(const TilemapComponent &tilemap, const TileSources &sources, sf::RenderTarget &target,
+              const sf::RenderStates &states, const sf::FloatRect &visible);
+
+  private:
+    bool rebuild(const TilemapComponent &tilemap, const TileSources &sources);
+    void encodeTile(const TilemapComponent &tilemap, const TileSources &sources, int x, int y,
+                    sf::Uint8 *texel) const;
+    void flushDirty(const TilemapComponent &tilemap, const TileSources &sources);
+
+    bool needsRebuild{true};
+    bool eligible{false};
+    int width{0};
+    int height{0};
+    const sf::Texture *atlas{nullptr};
+    sf::Vector2i regionSize;
+    sf::Texture idTexture;
+    sf::Texture regionTable;
+    std::vector<sf::Uint8> texels;       // CPU copy of idTexture
+    std::vector<sf::Vector2i> dirtyTiles; // pending single-texel updates
+};
+
+#endif // DDD_RENDER_TILEMAP_SHADER_RENDERER_H
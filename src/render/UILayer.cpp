@@ -0,0 +1,29 @@
+#include "render/UILayer.h"
+
+bool UILayer::ensureTexture(const sf::Vector2u &size) {
+    if (size.x == 0 || size.y == 0)
+        return false;
+    if (texture && texture->getSize() == size)
+        return true;
+    if (failed && failedSize == size)
+        return false;
+
+    auto created = std::make_unique<sf::RenderTexture>();
+    if (!created->create(size.x, size.y)) {
+        texture.reset();
+        failed = true;
+        failedSize = size;
+        return false;
+    }
+    texture = std::move(created);
+    failed = false;
+    dirty = true;
+    return true;
+}
+
+void UILayer::composite(sf::RenderTarget &target) const {
+    // Drawing with BlendAlpha onto a transparent texture leaves premultiplied colour, so composite as such.
+    static const sf::BlendMode kPremultiplied(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+    sf::Sprite sprite(texture->getTexture());
+    target.draw(sprite, sf::RenderStates(kPremultiplied));
+}
@@ -0,0 +1,42 @@
+#ifndef DDD_RENDER_UI_LAYER_H
+#define DDD_RENDER_UI_LAYER_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+
+// Retained UI layer: a target-sized render texture that is redrawn only when the caller's version number
+// (or the target size) changes and is otherwise composited with a single draw call.
+// Falls back to drawing straight into the target when the render texture cannot be created.
+class UILayer {
+  public:
+    // drawFn(sf::RenderTarget &) draws the layer contents in target pixels (default view).
+    template <typename DrawFn> void render(sf::RenderTarget &target, std::uint64_t version, DrawFn &&drawFn) {
+        if (!ensureTexture(target.getSize())) {
+            drawFn(target);
+            return;
+        }
+        if (dirty || version != cachedVersion) {
+            texture->clear(sf::Color::Transparent);
+            drawFn(*texture);
+            texture->display();
+            cachedVersion = version;
+            dirty = false;
+        }
+        composite(target);
+    }
+
+    void invalidate() { dirty = true; }
+
+  private:
+    bool ensureTexture(const sf::Vector2u &size);
+    void composite(sf::RenderTarget &target) const;
+
+    std::unique_ptr<sf::RenderTexture> texture;
+    bool failed{false}; // creation failed for this size; retried when the size changes
+    sf::Vector2u failedSize;
+    std::uint64_t cachedVersion{0};
+    bool dirty{true};
+};
+
+#endif // DDD_RENDER_UI_LAYER_H
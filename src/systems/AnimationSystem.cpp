@@ -0,0 +1,45 @@
+#include "systems/AnimationSystem.h"
+
+#include <cmath>
+
+AnimationSystem::AnimationSystem(EntityManager &entityMgr, const AnimationLibrary &animationLibrary)
+    : entityManager(entityMgr), library(animationLibrary) {}
+
+void AnimationSystem::rebuild() {
+    animators.clear();
+    for (auto &entPtr : entityManager.all()) {
+        auto *animation = entPtr->get<AnimationComponent>();
+        auto *sprite = entPtr->get<SpriteComponent>();
+        if (!animation || !sprite)
+            continue;
+        // Frames come from the clip's texture; a leftover region name would take precedence when drawing.
+        sprite->atlasRegion.clear();
+        sprite->region = kInvalidHandle;
+        sprite->useTextureRect = true;
+        animators.push_back({animation, sprite});
+    }
+    builtVersion = entityManager.getVersion();
+}
+
+void AnimationSystem::update(float dt) {
+    if (builtVersion != entityManager.getVersion())
+        rebuild();
+
+    for (const Animator &a : animators) {
+        AnimationComponent &anim = *a.animation;
+        const AnimationLibrary::Clip *clip = library.clip(anim.clip);
+        if (!clip)
+            continue;
+        const float length = clip->frameDuration * static_cast<float>(clip->frames.size());
+        anim.time += dt;
+        if (anim.time >= length)
+            anim.time = clip->loop ? std::fmod(anim.time, length) : length;
+        std::size_t frame = static_cast<std::size_t>(anim.time / clip->frameDuration);
+        if (frame >= clip->frames.size())
+            frame = clip->frames.size() - 1;
+
+        SpriteComponent &sprite = *a.sprite;
+        sprite.texture = clip->texture;
+        sprite.textureRect = clip->frames[frame];
+    }
+}
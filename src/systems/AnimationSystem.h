@@ -0,0 +1,34 @@
+#ifndef DDD_SYSTEMS_ANIMATION_SYSTEM_H
+#define DDD_SYSTEMS_ANIMATION_SYSTEM_H
+
+#include "components/AnimationComponent.h"
+#include "components/SpriteComponent.h"
+#include "core/EntityManager.h"
+#include "core/System.h"
+#include "managers/AnimationLibrary.h"
+#include <cstdint>
+#include <vector>
+
+// Advances every AnimationComponent and writes the current frame (texture handle + rect) into the sprite.
+// Animated entities are gathered into a flat list only when entities or their components are added or removed
+// (EntityManager::getVersion), so a frame is one pass over that list with no component or name lookups.
+class AnimationSystem : public System {
+  public:
+    AnimationSystem(EntityManager &entityMgr, const AnimationLibrary &library);
+    void update(float dt) override;
+
+  private:
+    struct Animator {
+        AnimationComponent *animation{nullptr};
+        SpriteComponent *sprite{nullptr};
+    };
+
+    void rebuild();
+
+    EntityManager &entityManager;
+    const AnimationLibrary &library;
+    std::vector<Animator> animators;
+    std::uint64_t builtVersion{~0ull};
+};
+
+#endif // DDD_SYSTEMS_ANIMATION_SYSTEM_H
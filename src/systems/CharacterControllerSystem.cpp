@@ -0,0 +1,210 @@
+#include "systems/CharacterControllerSystem.h"
+
+#include "utils/CoordinateUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kEps = 1e-4f;
+
+int tileX(const TilemapComponent &map, float wx) { return static_cast<int>(std::floor((wx - map.origin.x) / map.tileSize)); }
+int tileY(const TilemapComponent &map, float wy) { return static_cast<int>(std::floor((map.origin.y - wy) / map.tileSize)); }
+
+// World-space edges of a tile column/row (data y grows downward, world y up).
+float columnLeft(const TilemapComponent &map, int x) { return map.origin.x + static_cast<float>(x) * map.tileSize; }
+float rowTop(const TilemapComponent &map, int y) { return map.origin.y - static_cast<float>(y) * map.tileSize; }
+
+bool solidAt(const TilemapComponent &map, int x, int y) { return map.solidAt(x, y); }
+} // namespace
+
+CharacterControllerSystem::CharacterControllerSystem(EntityManager &entityMgr, PhysicsManager &physicsMgr)
+    : entityManager(entityMgr), physicsManager(physicsMgr) {}
+
+TilemapComponent *CharacterControllerSystem::findTilemap() {
+    if (tilemapEntityId != kInvalidEntityId) {
+        if (Entity *e = entityManager.find(tilemapEntityId))
+            return e->get<TilemapComponent>();
+    }
+    for (auto &entPtr : entityManager.all()) {
+        if (auto *map = entPtr->get<TilemapComponent>()) {
+            tilemapEntityId = entPtr->getId();
+            return map;
+        }
+    }
+    tilemapEntityId = kInvalidEntityId;
+    return nullptr;
+}
+
+void CharacterControllerSystem::update(float dt) {
+    if (dt <= 0.0f)
+        return;
+    const TilemapComponent *map = findTilemap();
+
+    for (auto &entPtr : entityManager.all()) {
+        auto *ctrl = entPtr->get<CharacterControllerComponent>();
+        auto *transform = entPtr->get<TransformComponent>();
+        if (!ctrl || !transform)
+            continue;
+
+        const Vec2 start = transform->position;
+        Vec2 pos = start;
+        move(*ctrl, map, pos, dt);
+
+        if (auto *grounded = entPtr->get<GroundedComponent>())
+            grounded->grounded = ctrl->grounded;
+
+        auto *bodyComp = entPtr->get<PhysicsBodyComponent>();
+        if (bodyComp && bodyComp->body) {
+            // Kinematic proxy: Box2D integrates this velocity over the same dt and lands on `pos`.
+            const Vec2 bodyPos = physicsToWorld(Vec2{bodyComp->body->GetPosition()});
+            const Vec2 v = worldToPhysics((pos - bodyPos) / dt);
+            bodyComp->body->SetLinearVelocity(b2Vec2{v.x, v.y});
+        } else {
+            transform->position = pos;
+            if (bodyComp)
+                bodyComp->position = pos;
+        }
+    }
+}
+
+void CharacterControllerSystem::move(CharacterControllerComponent &ctrl, const TilemapComponent *map, Vec2 &pos,
+                                     float dt) {
+    const b2Vec2 gravity = physicsManager.getWorld().GetGravity();
+
+    ctrl.velocity.x = std::clamp(ctrl.moveInput, -1.0f, 1.0f) * ctrl.moveSpeed;
+    if (ctrl.grounded && ctrl.velocity.y < 0.0f)
+        ctrl.velocity.y = 0.0f;
+
+    if (ctrl.jumpRequested && (ctrl.grounded || ctrl.coyoteTimer > 0.0f)) {
+        ctrl.velocity.y = ctrl.jumpSpeed;
+        ctrl.coyoteTimer = 0.0f;
+        ctrl.grounded = false;
+    }
+    ctrl.jumpRequested = false;
+
+    ctrl.velocity.y = std::max(ctrl.velocity.y + physicsToWorld(Vec2{gravity}).y * dt, -ctrl.maxFallSpeed);
+
+    if (!map || map->tileSize <= 0.0f) {
+        pos += ctrl.velocity * dt;
+        ctrl.grounded = false;
+        return;
+    }
+
+    const Vec2 half = ctrl.halfExtents;
+    const Vec2 delta = ctrl.velocity * dt;
+
+    // Sub-step so a single sweep never spans more than half a tile on either axis.
+    const float maxMove = std::max(std::abs(delta.x), std::abs(delta.y));
+    const int subSteps = std::max(1, static_cast<int>(std::ceil(maxMove / (map->tileSize * 0.5f))));
+    const Vec2 stepDelta = delta / static_cast<float>(subSteps);
+
+    bool wasGrounded = ctrl.grounded;
+    for (int i = 0; i < subSteps; ++i) {
+        const float wantX = pos.x + stepDelta.x;
+        const float newX = sweepX(*map, pos, half, stepDelta.x);
+        if (std::abs(newX - wantX) > kEps && wasGrounded && ctrl.stepHeight > 0.0f) {
+            // Step-up: lift, retry the horizontal move, settle back down.
+            Vec2 raised = pos;
+            raised.y = sweepY(*map, pos, half, ctrl.stepHeight);
+            if (raised.y - pos.y >= ctrl.stepHeight - kEps) {
+                const float raisedX = sweepX(*map, raised, half, stepDelta.x);
+                if (std::abs(raisedX - pos.x) > std::abs(newX - pos.x) + kEps) {
+                    raised.x = raisedX;
+                    raised.y = sweepY(*map, raised, half, -ctrl.stepHeight);
+                    pos = raised;
+                    wasGrounded = isGroundedAt(*map, pos, half);
+                    continue;
+                }
+            }
+        }
+        if (std::abs(newX - wantX) > kEps)
+            ctrl.velocity.x = 0.0f;
+        pos.x = newX;
+
+        const float wantY = pos.y + stepDelta.y;
+        pos.y = sweepY(*map, pos, half, stepDelta.y);
+        if (std::abs(pos.y - wantY) > kEps)
+            ctrl.velocity.y = 0.0f;
+        wasGrounded = isGroundedAt(*map, pos, half);
+    }
+
+    ctrl.grounded = isGroundedAt(*map, pos, half);
+    if (ctrl.grounded)
+        ctrl.coyoteTimer = ctrl.coyoteTime;
+    else
+        ctrl.coyoteTimer = std::max(0.0f, ctrl.coyoteTimer - dt);
+}
+
+bool CharacterControllerSystem::isGroundedAt(const TilemapComponent &map, const Vec2 &pos, const Vec2 &half) {
+    const float bottom = pos.y - half.y;
+    const int row = tileY(map, bottom - kEps);
+    if (std::abs(rowTop(map, row) - bottom) > 2.0f * kEps)
+        return false;
+    const int x0 = tileX(map, pos.x - half.x + kEps);
+    const int x1 = tileX(map, pos.x + half.x - kEps);
+    return map.anySolidInRow(row, x0, x1);
+}
+
+float CharacterControllerSystem::sweepX(const TilemapComponent &map, const Vec2 &pos, const Vec2 &half, float dx) {
+    if (dx == 0.0f)
+        return pos.x;
+    const int y0 = tileY(map, pos.y + half.y - kEps);
+    const int y1 = tileY(map, pos.y - half.y + kEps);
+
+    if (dx > 0.0f) {
+        const float from = pos.x + half.x;
+        const float to = from + dx;
+        for (int x = tileX(map, from); x <= tileX(map, to); ++x) {
+            const float left = columnLeft(map, x);
+            if (left < from - kEps)
+                continue; // column already overlapped, not being entered
+            for (int y = y0; y <= y1; ++y) {
+                if (solidAt(map, x, y))
+                    return left - half.x;
+            }
+        }
+    } else {
+        const float from = pos.x - half.x;
+        const float to = from + dx;
+        for (int x = tileX(map, from); x >= tileX(map, to); --x) {
+            const float right = columnLeft(map, x + 1);
+            if (right > from + kEps)
+                continue;
+            for (int y = y0; y <= y1; ++y) {
+                if (solidAt(map, x, y))
+                    return right + half.x;
+            }
+        }
+    }
+    return pos.x + dx;
+}
+
+float CharacterControllerSystem::sweepY(const TilemapComponent &map, const Vec2 &pos, const Vec2 &half, float dy) {
+    if (dy == 0.0f)
+        return pos.y;
+    const int x0 = tileX(map, pos.x - half.x + kEps);
+    const int x1 = tileX(map, pos.x + half.x - kEps);
+
+    if (dy < 0.0f) {
+        const float from = pos.y - half.y;
+        const float to = from + dy;
+        for (int y = tileY(map, from); y <= tileY(map, to); ++y) {
+            const float top = rowTop(map, y);
+            if (top > from + kEps)
+                continue;
+            if (map.anySolidInRow(y, x0, x1))
+                return top + half.y;
+        }
+    } else {
+        const float from = pos.y + half.y;
+        const float to = from + dy;
+        for (int y = tileY(map, from); y >= tileY(map, to); --y) {
+            const float bottom = rowTop(map, y + 1);
+            if (bottom < from - kEps)
+                continue;
+            if (map.anySolidInRow(y, x0, x1))
+                return bottom - half.y;
+        }
+    }
+    return pos.y + dy;
+}
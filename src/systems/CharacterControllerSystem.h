@@ -0,0 +1,36 @@
+#ifndef DDD_SYSTEMS_CHARACTER_CONTROLLER_SYSTEM_H
+#define DDD_SYSTEMS_CHARACTER_CONTROLLER_SYSTEM_H
+
+#include "components/CharacterControllerComponent.h"
+#include "components/GroundedComponent.h"
+#include "components/PhysicsBodyComponent.h"
+#include "components/TilemapComponent.h"
+#include "components/TransformComponent.h"
+#include "core/EntityManager.h"
+#include "core/System.h"
+#include "managers/PhysicsManager.h"
+
+// Runs at fixed step right before PhysicsSystem: moves controllers against the tile grid, then hands the
+// resulting displacement to the kinematic proxy body as a velocity so Box2D reproduces it exactly.
+class CharacterControllerSystem : public System {
+  public:
+    CharacterControllerSystem(EntityManager &entityMgr, PhysicsManager &physicsMgr);
+    void update(float dt) override;
+
+    // Exact grounded test: bottom edge rests on a solid tile row.
+    static bool isGroundedAt(const TilemapComponent &map, const Vec2 &pos, const Vec2 &half);
+
+  private:
+    TilemapComponent *findTilemap();
+    void move(CharacterControllerComponent &ctrl, const TilemapComponent *map, Vec2 &pos, float dt);
+
+    static float sweepX(const TilemapComponent &map, const Vec2 &pos, const Vec2 &half, float dx);
+    static float sweepY(const TilemapComponent &map, const Vec2 &pos, const Vec2 &half, float dy);
+
+    EntityManager &entityManager;
+    PhysicsManager &physicsManager;
+    Entity::Id tilemapEntityId{kInvalidEntityId};
+    static constexpr Entity::Id kInvalidEntityId = static_cast<Entity::Id>(-1);
+};
+
+#endif // DDD_SYSTEMS_CHARACTER_CONTROLLER_SYSTEM_H
@@ -62,7 +62,15 @@ void DebugSystem::update(float dt) {
         oss2 << "Tile: (" << tx << ", " << ty << ")";
         if (tilemap->inBounds(tx, ty)) {
             const int tid = tilemap->get(tx, ty);
-            oss2 << " id=" << tid << (tilemap->isSolid(tid) ? " solid" : " air");
+            const TileProperties &props = tilemap->properties(tid);
+            oss2 << " id=" << tid << (props.has(TileProperties::Solid) ? " solid" : " air");
+            if (props.has(TileProperties::Liquid))
+                oss2 << " liquid";
+            if (!props.has(TileProperties::Breakable))
+                oss2 << " unbreakable";
+            oss2 << " hardness=" << props.hardness << " drop=" << tilemap->registry.dropItem(tid);
+            if (props.light > 0)
+                oss2 << " light=" << static_cast<int>(props.light);
         } else {
             oss2 << " out_of_bounds";
         }
@@ -95,7 +103,7 @@ void DebugSystem::update(float dt) {
                     d << " tile=(" << tx << "," << ty << ")";
                     if (tilemap->inBounds(tx, ty)) {
                         const int tid = tilemap->get(tx, ty);
-                        d << " tid=" << tid << (tilemap->isSolid(tid) ? " solid" : " air");
+                        d << " tid=" << tid << (tilemap->registry.solid(tid) ? " solid" : " air");
                     } else {
                         d << " oob";
                     }
@@ -29,32 +29,28 @@ void DropPickupSystem::update(float dt) {
     if (!playerTransform)
         return;
 
-    const float radius2 = pickupRadius * pickupRadius;
-    std::vector<Entity::Id> toRemove;
-
-    for (auto &entPtr : entityManager.all()) {
-        auto *drop = entPtr->get<DropComponent>();
-        auto *transform = entPtr->get<TransformComponent>();
-        if (!drop || !transform)
+    // Collect first: removing from the index while it is being visited would invalidate the cell.
+    nearby.clear();
+    const std::uint32_t dropMask = CollisionMatrix::categoryBit(CollisionLayer::Drop);
+    spatialIndex.queryRadius(playerTransform->position, pickupRadius, dropMask,
+                             [this](Entity::Id id, const Vec2 &) { nearby.push_back(id); });
+
+    for (Entity::Id id : nearby) {
+        Entity *ent = entityManager.find(id);
+        if (!ent)
             continue;
-
-        const float dx = transform->position.x - playerTransform->position.x;
-        const float dy = transform->position.y - playerTransform->position.y;
-        const float dist2 = dx * dx + dy * dy;
-        if (dist2 > radius2)
+        auto *drop = ent->get<DropComponent>();
+        if (!drop)
             continue;
 
         const int remaining = inventorySystem.addItem(player->getId(), drop->itemId, drop->count);
         if (remaining <= 0) {
-            destroyBodyIfAny(*entPtr);
-            toRemove.push_back(entPtr->getId());
+            destroyBodyIfAny(*ent);
+            spatialIndex.remove(id);
+            entityManager.remove(id);
         } else {
             drop->count = remaining;
         }
     }
-
-    for (auto id : toRemove) {
-        entityManager.remove(id);
-    }
 }
 
@@ -8,14 +8,17 @@
 #include "core/EntityManager.h"
 #include "core/System.h"
 #include "managers/PhysicsManager.h"
+#include "managers/SpatialIndex.h"
 #include "systems/InventorySystem.h"
 #include "utils/Vec2.h"
 #include <vector>
 
 class DropPickupSystem : public System {
   public:
-    DropPickupSystem(EntityManager &entityMgr, InventorySystem &inventorySys, PhysicsManager &physicsMgr, float radius)
-        : entityManager(entityMgr), inventorySystem(inventorySys), physicsManager(physicsMgr), pickupRadius(radius) {}
+    DropPickupSystem(EntityManager &entityMgr, InventorySystem &inventorySys, PhysicsManager &physicsMgr,
+                     SpatialIndex &spatialIdx, float radius)
+        : entityManager(entityMgr), inventorySystem(inventorySys), physicsManager(physicsMgr), spatialIndex(spatialIdx),
+          pickupRadius(radius) {}
 
     void update(float dt) override;
 
@@ -26,7 +29,9 @@ class DropPickupSystem : public System {
     EntityManager &entityManager;
     InventorySystem &inventorySystem;
     PhysicsManager &physicsManager;
+    SpatialIndex &spatialIndex;
     float pickupRadius{1.5f};
+    std::vector<Entity::Id> nearby; // reused between frames
 };
 
 #endif // DDD_SYSTEMS_DROP_PICKUP_SYSTEM_H
@@ -0,0 +1,147 @@
+#include "systems/ParticleSystem.h"
+
+#include "components/TransformComponent.h"
+#include <algorithm>
+
+namespace {
+
+ParticlePool::Settings debrisSettings() {
+    ParticlePool::Settings s;
+    s.capacity = ParticleSystem::kDebrisCapacity;
+    s.gravity = -20.0f;
+    s.drag = 0.5f;
+    s.collide = true;
+    s.restitution = 0.3f;
+    return s;
+}
+
+ParticlePool::Settings sparkleSettings() {
+    ParticlePool::Settings s;
+    s.capacity = ParticleSystem::kSparkleCapacity;
+    s.gravity = 2.0f; // drifts upward
+    s.drag = 2.0f;
+    return s;
+}
+
+std::uint32_t packColor(int r, int g, int b, int a = 255) {
+    const auto c = [](int v) { return static_cast<std::uint32_t>(std::clamp(v, 0, 255)); };
+    return (c(r) << 24) | (c(g) << 16) | (c(b) << 8) | c(a);
+}
+
+} // namespace
+
+ParticleSystem::ParticleSystem(EntityManager &entityMgr, EventBus &eventBus)
+    : entityManager(entityMgr), debris(debrisSettings()), sparkles(sparkleSettings()) {
+    eventBus.subscribe<BreakBlockEvent>([this](const BreakBlockEvent &ev) { emitBlockBreak(ev); });
+    eventBus.subscribe<InventoryDropAddedEvent>([this](const InventoryDropAddedEvent &ev) { emitPickup(ev); });
+}
+
+void ParticleSystem::clear() {
+    debris.clear();
+    sparkles.clear();
+}
+
+const TilemapComponent *ParticleSystem::findTilemap() {
+    if (tilemapId != kInvalidEntityId) {
+        if (Entity *cached = entityManager.find(tilemapId)) {
+            if (const auto *tilemap = cached->get<TilemapComponent>())
+                return tilemap;
+        }
+    } else if (scannedVersion == entityManager.getVersion()) {
+        return nullptr; // no map (menus) and no entity or component added since the last scan
+    }
+    for (auto &entPtr : entityManager.all()) {
+        if (const auto *tilemap = entPtr->get<TilemapComponent>()) {
+            // A different map (reload): old particles belong to the old world.
+            clear();
+            tilemapId = entPtr->getId();
+            refreshTileGrid(tilemap);
+            return tilemap;
+        }
+    }
+    tilemapId = kInvalidEntityId;
+    scannedVersion = entityManager.getVersion();
+    refreshTileGrid(nullptr);
+    return nullptr;
+}
+
+void ParticleSystem::refreshTileGrid(const TilemapComponent *tilemap) {
+    tileGrid = ParticleTileGrid{};
+    if (!tilemap || tilemap->tileSize <= 0.0f)
+        return;
+    tileGrid.width = tilemap->width;
+    tileGrid.height = tilemap->height;
+    tileGrid.originX = tilemap->origin.x;
+    tileGrid.originY = tilemap->origin.y;
+    tileGrid.invTileSize = 1.0f / tilemap->tileSize;
+}
+
+void ParticleSystem::update(float dt) {
+    const TilemapComponent *tilemap = findTilemap();
+    tileGrid.tiles = tilemap ? &tilemap->tiles : nullptr;
+
+    debris.integrate(dt, &tileGrid);
+    debris.compact();
+    sparkles.integrate(dt, nullptr);
+    sparkles.compact();
+}
+
+void ParticleSystem::appendPool(const ParticlePool &pool, ParticleSnapshot &out) {
+    const std::size_t n = pool.getCount();
+    out.x.insert(out.x.end(), pool.x(), pool.x() + n);
+    out.y.insert(out.y.end(), pool.y(), pool.y() + n);
+    out.size.insert(out.size.end(), pool.sizes(), pool.sizes() + n);
+    const std::uint32_t *colors = pool.colors();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t c = colors[i];
+        const auto alpha = static_cast<sf::Uint8>(static_cast<float>(c & 0xFFu) * pool.lifeFraction(i));
+        out.color.emplace_back(static_cast<sf::Uint8>(c >> 24), static_cast<sf::Uint8>(c >> 16),
+                               static_cast<sf::Uint8>(c >> 8), alpha);
+    }
+}
+
+void ParticleSystem::extract(ParticleSnapshot &out) const {
+    out.clear();
+    appendPool(debris, out);
+    appendPool(sparkles, out);
+}
+
+void ParticleSystem::emitBlockBreak(const BreakBlockEvent &ev) {
+    const TilemapComponent *tilemap = findTilemap();
+    if (!tilemap)
+        return;
+    const float cx = tilemap->origin.x + (static_cast<float>(ev.x) + 0.5f) * tilemap->tileSize;
+    const float cy = tilemap->origin.y - (static_cast<float>(ev.y) + 0.5f) * tilemap->tileSize;
+
+    // Stable earthy tint per tile id, varied per chip.
+    const unsigned h = static_cast<unsigned>(ev.previousTileId) * 2654435761u;
+    const int baseR = 110 + static_cast<int>((h >> 24) % 90);
+    const int baseG = 80 + static_cast<int>((h >> 16) % 80);
+    const int baseB = 50 + static_cast<int>((h >> 8) % 60);
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const float half = tilemap->tileSize * 0.4f;
+    for (int i = 0; i < 14; ++i) {
+        const float shade = 0.75f + 0.5f * unit(rng);
+        debris.spawn(cx + (unit(rng) * 2.0f - 1.0f) * half, cy + (unit(rng) * 2.0f - 1.0f) * half,
+                     (unit(rng) * 2.0f - 1.0f) * 3.0f, 2.0f + unit(rng) * 4.0f, 0.6f + unit(rng) * 0.6f,
+                     tilemap->tileSize * (0.1f + unit(rng) * 0.1f),
+                     packColor(static_cast<int>(baseR * shade), static_cast<int>(baseG * shade),
+                               static_cast<int>(baseB * shade)));
+    }
+}
+
+void ParticleSystem::emitPickup(const InventoryDropAddedEvent &ev) {
+    Entity *entity = entityManager.find(ev.entityId);
+    const TransformComponent *transform = entity ? entity->get<TransformComponent>() : nullptr;
+    if (!transform)
+        return;
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const int count = std::min(24, 6 + 2 * ev.added);
+    for (int i = 0; i < count; ++i) {
+        sparkles.spawn(transform->position.x + (unit(rng) - 0.5f) * 0.6f, transform->position.y + unit(rng) * 0.5f,
+                       (unit(rng) - 0.5f) * 1.5f, 1.0f + unit(rng) * 1.5f, 0.35f + unit(rng) * 0.3f,
+                       0.06f + unit(rng) * 0.06f, packColor(255, 210 + static_cast<int>(unit(rng) * 40.0f), 90));
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef DDD_SYSTEMS_PARTICLE_SYSTEM_H
+#define DDD_SYSTEMS_PARTICLE_SYSTEM_H
+
+#include "components/TilemapComponent.h"
+#include "core/EntityManager.h"
+#include "core/EventBus.h"
+#include "core/System.h"
+#include "events/InventoryEvents.h"
+#include "events/TileEvents.h"
+#include "render/RenderSnapshot.h"
+#include "utils/ParticlePool.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Visual-only particles kept outside the ECS: block-break debris (gravity, bounces off solid tiles) and
+// pickup sparkles. Simulated on the update thread; extract() copies live particles into the render snapshot.
+class ParticleSystem : public System {
+  public:
+    static constexpr std::size_t kDebrisCapacity = 65536;
+    static constexpr std::size_t kSparkleCapacity = 16384;
+
+    ParticleSystem(EntityManager &entityMgr, EventBus &eventBus);
+    void update(float dt) override;
+    void extract(ParticleSnapshot &out) const;
+    void clear();
+
+  private:
+    const TilemapComponent *findTilemap();
+    void refreshTileGrid(const TilemapComponent *tilemap);
+    void emitBlockBreak(const BreakBlockEvent &ev);
+    void emitPickup(const InventoryDropAddedEvent &ev);
+    static void appendPool(const ParticlePool &pool, ParticleSnapshot &out);
+
+    EntityManager &entityManager;
+
+    ParticlePool debris;
+    ParticlePool sparkles;
+    std::minstd_rand rng{0x5eed};
+
+    Entity::Id tilemapId{kInvalidEntityId};
+    std::uint64_t scannedVersion{~0ull}; // EntityManager::getVersion() of the last scan that found no map
+    static constexpr Entity::Id kInvalidEntityId = static_cast<Entity::Id>(-1);
+    ParticleTileGrid tileGrid;
+};
+
+#endif // DDD_SYSTEMS_PARTICLE_SYSTEM_H
@@ -13,23 +13,33 @@
 #include "events/PhysicsEvents.h"
 #include "events/TileEvents.h"
 #include "managers/PhysicsManager.h"
+#include "managers/SpatialIndex.h"
 #include "utils/Constants.h"
 #include "utils/CoordinateUtils.h"
 #include <SFML/Graphics/Rect.hpp>
 #include <box2d/box2d.h>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 class PhysicsSystem : public System {
   public:
-    PhysicsSystem(PhysicsManager &physicsManager, EntityManager &entityManager, EventBus &eventBus)
-        : physicsManager(physicsManager), entityManager(entityManager), eventBus(eventBus),
+    PhysicsSystem(PhysicsManager &physicsManager, EntityManager &entityManager, EventBus &eventBus,
+                  SpatialIndex &spatialIndex)
+        : physicsManager(physicsManager), entityManager(entityManager), eventBus(eventBus), spatialIndex(spatialIndex),
           contactListener(eventBus) {
         physicsManager.getWorld().SetContactListener(&contactListener);
 
-        eventBus.subscribe<PlaceBlockEvent>([this](const PlaceBlockEvent &ev) { handlePlace(ev); });
+        eventBus.subscribe<TileChangedBatch>([this](const TileChangedBatch &ev) { handleTileBatch(ev); });
         eventBus.subscribe<BreakBlockEvent>([this](const BreakBlockEvent &ev) { handleBreak(ev); });
+        eventBus.subscribe<ChunkLoadedEvent>([this](const ChunkLoadedEvent &ev) { handleChunkLoaded(ev); });
+        eventBus.subscribe<ChunkUnloadedEvent>([this](const ChunkUnloadedEvent &ev) { handleChunkUnloaded(ev); });
     }
 
     ~PhysicsSystem() override { shutdown(); }
@@ -38,7 +48,10 @@ class PhysicsSystem : public System {
 
     void reset() {
         shutdown();
+        contactListener.clear();
+        spatialIndex.clear();
         clearTilemapColliders();
+        parkedBodies.clear();
         tilemapInitialized = false;
         tilemapEntityId = kInvalidEntityId;
         mapOwnerId = kInvalidEntityId;
@@ -50,10 +63,41 @@ class PhysicsSystem : public System {
 
         ensureBodies();
         ensureTilemapColliders();
-        physicsManager.getWorld().Step(dt, PHYSICS_VELOCITY_ITER, PHYSICS_POSITION_ITER);
+        physicsManager.getWorld().Step(dt, velocityIterations, positionIterations);
         syncTransforms();
     }
 
+    void setSolverIterations(int velocityIter, int positionIter) {
+        velocityIterations = velocityIter;
+        positionIterations = positionIter;
+    }
+    int getVelocityIterations() const { return velocityIterations; }
+    int getPositionIterations() const { return positionIterations; }
+
+    // Contact interest registration. Pairs where neither fixture is watched never reach the EventBus.
+    void watchContactLayer(CollisionLayer layer) { contactListener.watchLayer(layer); }
+
+    // Watches every fixture created for entities carrying component Tag (evaluated at body creation).
+    template <typename Tag> void watchContactTag() {
+        contactTagFilters.push_back([](const Entity &e) { return e.has<Tag>(); });
+    }
+
+    // Sprite region of a dropped item. Items are not tile data, so the owner resolves it from the item
+    // definitions; without a lookup (or an invalid result) drops keep the default texture rect.
+    using DropRegionLookup = std::function<RegionHandle(const TilemapComponent &map, int itemId)>;
+    void setDropRegionLookup(DropRegionLookup lookup) { dropRegionLookup = std::move(lookup); }
+
+    // Aggregated number of touching contacts for the entity (tile colliders are not tracked).
+    int getContactCount(Entity::Id id) const { return contactListener.contactCount(id); }
+
+    // Dynamic bodies held out of the simulation because the chunk under them is not resident.
+    std::size_t getParkedBodyCount() const {
+        std::size_t count = 0;
+        for (const auto &entry : parkedBodies)
+            count += entry.second.size();
+        return count;
+    }
+
   private:
     class ContactListener : public b2ContactListener {
       public:
@@ -62,6 +106,15 @@ class PhysicsSystem : public System {
         void BeginContact(b2Contact *contact) override { handle(contact, true); }
         void EndContact(b2Contact *contact) override { handle(contact, false); }
 
+        void watchLayer(CollisionLayer layer) { watchedCategories |= CollisionMatrix::categoryBit(layer); }
+
+        int contactCount(Entity::Id id) const {
+            auto it = counts.find(id);
+            return it != counts.end() ? it->second : 0;
+        }
+
+        void clear() { counts.clear(); }
+
       private:
         static FixtureTag *getTag(const b2Fixture *fixture) {
             if (!fixture)
@@ -69,21 +122,37 @@ class PhysicsSystem : public System {
             return reinterpret_cast<FixtureTag *>(fixture->GetUserData().pointer);
         }
 
+        bool wantsEvent(const FixtureTag &tag) const {
+            return tag.reportContacts || (watchedCategories & CollisionMatrix::categoryBit(tag.layer)) != 0;
+        }
+
+        void count(const FixtureTag &tag, int delta) {
+            // Every tile collider shares the map entity id; counting them would only grow one hot entry.
+            if (tag.layer == CollisionLayer::Tile)
+                return;
+            int &c = counts[tag.entityId];
+            c += delta;
+            if (c == 0)
+                counts.erase(tag.entityId);
+        }
+
         void handle(b2Contact *contact, bool isBegin) {
             auto *tagA = getTag(contact->GetFixtureA());
             auto *tagB = getTag(contact->GetFixtureB());
             if (!tagA || !tagB)
                 return;
 
-            eventBus.emit(ContactEvent{tagA->entityId, tagB->entityId, isBegin});
+            const int delta = isBegin ? 1 : -1;
+            count(*tagA, delta);
+            count(*tagB, delta);
 
-            if (tagA->isFootSensor)
-                eventBus.emit(GroundedEvent{tagA->entityId, isBegin});
-            if (tagB->isFootSensor)
-                eventBus.emit(GroundedEvent{tagB->entityId, isBegin});
+            if (wantsEvent(*tagA) || wantsEvent(*tagB))
+                eventBus.emit(ContactEvent{tagA->entityId, tagB->entityId, tagA->layer, tagB->layer, isBegin});
         }
 
         EventBus &eventBus;
+        std::uint16_t watchedCategories{0};
+        std::unordered_map<Entity::Id, int> counts;
     };
 
     void ensureBodies() {
@@ -98,6 +167,7 @@ class PhysicsSystem : public System {
                 bodyComp->body = nullptr;
                 bodyComp->fixtureTags.clear();
                 bodyComp->pendingDestroy = false;
+                spatialIndex.remove(entPtr->getId());
                 continue;
             }
 
@@ -109,17 +179,19 @@ class PhysicsSystem : public System {
                 bodyComp->fixtureTags.clear();
                 auto tag = std::make_unique<FixtureTag>();
                 tag->entityId = entPtr->getId();
+                tag->layer = bodyComp->fixture.layer;
                 tag->isSensor = bodyComp->fixture.isSensor;
-                tag->isFootSensor = bodyComp->fixture.isFootSensor;
+                for (const auto &filter : contactTagFilters) {
+                    if (filter(*entPtr)) {
+                        tag->reportContacts = true;
+                        break;
+                    }
+                }
                 FixtureTag *rawTag = tag.get();
                 bodyComp->fixtureTags.push_back(std::move(tag));
 
                 b2Fixture *fixture = physicsManager.createFixture(*bodyComp->body, bodyComp->fixture, rawTag);
                 if (dropComp && fixture) {
-                b2Filter filter = fixture->GetFilterData();
-                filter.categoryBits = 0x0002;
-                filter.maskBits = 0xFFFF; // collide with everything, включая другие дропы
-                fixture->SetFilterData(filter);
                 bodyComp->body->SetSleepingAllowed(false);
                 bodyComp->body->SetAwake(true);
                 bodyComp->body->SetBullet(true);
@@ -131,12 +203,6 @@ class PhysicsSystem : public System {
                 bodyComp->body->SetAngularDamping(bodyComp->fixture.angularDamping);
 
                 if (dropComp) {
-                    for (b2Fixture *f = bodyComp->body->GetFixtureList(); f; f = f->GetNext()) {
-                        b2Filter filter = f->GetFilterData();
-                        filter.categoryBits = 0x0002;
-                        filter.maskBits = 0xFFFF;
-                        f->SetFilterData(filter);
-                    }
                 bodyComp->body->SetSleepingAllowed(false);
                 bodyComp->body->SetAwake(true);
                 bodyComp->body->SetBullet(true);
@@ -183,14 +249,105 @@ class PhysicsSystem : public System {
     void rebuildTilemapColliders(TilemapComponent &map) {
         clearTilemapColliders();
         mapOwnerId = tilemapEntityId;
-        for (int y = 0; y < map.height; ++y) {
-            for (int x = 0; x < map.width; ++x) {
-                const int tileId = map.get(x, y);
-                createTileBody(map, x, y, tileId);
+        // Only resident chunks get colliders; streamed chunks are added/removed by the chunk events.
+        map.tiles.forEach([&](TileChunkStore::Key key, const TileChunk &) {
+            createChunkBodies(map, TileChunkStore::keyX(key), TileChunkStore::keyY(key));
+        });
+    }
+
+    // Walks the chunk's solidity rows a word at a time; only solid tiles are visited.
+    void createChunkBodies(TilemapComponent &map, int chunkX, int chunkY) {
+        destroyChunkBodies(chunkX, chunkY);
+        const TileChunk *chunk = map.tiles.find(chunkX, chunkY);
+        if (!chunk)
+            return;
+        const int x0 = chunkX * TileChunkStore::kChunkSize;
+        const int y0 = chunkY * TileChunkStore::kChunkSize;
+        for (int ly = 0; ly < TileChunkStore::kChunkSize; ++ly) {
+            for (std::uint32_t row = chunk->solidRow(ly); row != 0; row &= row - 1) {
+                const int x = x0 + std::countr_zero(row);
+                createTileBody(map, x, y0 + ly, map.get(x, y0 + ly), /*replace=*/true);
             }
         }
     }
 
+    void destroyChunkBodies(int chunkX, int chunkY) {
+        if (tileBodies.empty())
+            return;
+        const int x0 = chunkX * TileChunkStore::kChunkSize;
+        const int y0 = chunkY * TileChunkStore::kChunkSize;
+        for (int y = y0; y < y0 + TileChunkStore::kChunkSize; ++y) {
+            for (int x = x0; x < x0 + TileChunkStore::kChunkSize; ++x) {
+                auto it = tileBodies.find({x, y});
+                if (it == tileBodies.end())
+                    continue;
+                if (it->second.body)
+                    physicsManager.destroyBody(it->second.body);
+                tileBodies.erase(it);
+            }
+        }
+    }
+
+    void handleChunkLoaded(const ChunkLoadedEvent &ev) {
+        TilemapComponent *map = findTilemap();
+        if (map && tilemapInitialized) // otherwise the first rebuild covers every resident chunk
+            createChunkBodies(*map, ev.chunkX, ev.chunkY);
+        unparkChunkBodies(ev.chunkX, ev.chunkY);
+    }
+
+    void handleChunkUnloaded(const ChunkUnloadedEvent &ev) {
+        if (TilemapComponent *map = findTilemap())
+            parkChunkBodies(*map, ev.chunkX, ev.chunkY);
+        destroyChunkBodies(ev.chunkX, ev.chunkY);
+    }
+
+    // Chunk key under a world position, or nothing when it lies outside the map (nothing streams there).
+    static std::optional<TileChunkStore::Key> chunkAt(const TilemapComponent &map, const Vec2 &pos) {
+        const int x = static_cast<int>(std::floor((pos.x - map.origin.x) / map.tileSize));
+        const int y = static_cast<int>(std::floor((map.origin.y - pos.y) / map.tileSize));
+        if (!map.inBounds(x, y))
+            return std::nullopt;
+        return TileChunkStore::keyForTile(x, y);
+    }
+
+    // Dynamic bodies lose their ground when the tile colliders under them go away with an evicted chunk, and
+    // drops only disappear on pickup, so they would fall out of the world. They are disabled instead and
+    // re-enabled once their chunk is resident again.
+    void parkBody(Entity::Id id, PhysicsBodyComponent &bodyComp, TileChunkStore::Key chunk) {
+        bodyComp.body->SetEnabled(false);
+        parkedBodies[chunk].push_back(id);
+    }
+
+    void parkChunkBodies(const TilemapComponent &map, int chunkX, int chunkY) {
+        const TileChunkStore::Key chunk = TileChunkStore::key(chunkX, chunkY);
+        const float size = map.tileSize * TileChunkStore::kChunkSize;
+        const Vec2 min{map.origin.x + chunkX * size, map.origin.y - (chunkY + 1) * size};
+        const Vec2 max{min.x + size, min.y + size};
+        spatialIndex.queryAABB(min, max, ~0u, [&](Entity::Id id, const Vec2 &pos) {
+            Entity *e = entityManager.find(id);
+            auto *bodyComp = e ? e->get<PhysicsBodyComponent>() : nullptr;
+            if (!bodyComp || !bodyComp->body || bodyComp->body->GetType() != b2_dynamicBody ||
+                !bodyComp->body->IsEnabled() || chunkAt(map, pos) != chunk)
+                return;
+            parkBody(id, *bodyComp, chunk);
+        });
+    }
+
+    void unparkChunkBodies(int chunkX, int chunkY) {
+        auto it = parkedBodies.find(TileChunkStore::key(chunkX, chunkY));
+        if (it == parkedBodies.end())
+            return;
+        for (Entity::Id id : it->second) {
+            Entity *e = entityManager.find(id);
+            auto *bodyComp = e ? e->get<PhysicsBodyComponent>() : nullptr;
+            if (bodyComp && bodyComp->body) {
+                bodyComp->body->SetEnabled(true);
+                bodyComp->body->SetAwake(true);
+            }
+        }
+        parkedBodies.erase(it);
+    }
+
     void clearTilemapColliders() {
         for (auto &entry : tileBodies) {
             if (entry.second.body)
@@ -199,22 +356,21 @@ class PhysicsSystem : public System {
         tileBodies.clear();
     }
 
-    void handlePlace(const PlaceBlockEvent &ev) {
-        if (TilemapComponent *map = findTilemap()) {
-            if (mapOwnerId == kInvalidEntityId)
-                mapOwnerId = tilemapEntityId;
-            createTileBody(*map, ev.x, ev.y, ev.tileId, /*replace=*/true);
-        }
+    // Colliders follow the frame's edits: changed cells get their bodies replaced, and bodies around each
+    // touched chunk's bounds are woken once.
+    void handleTileBatch(const TileChangedBatch &ev) {
+        TilemapComponent *map = findTilemap();
+        if (!map)
+            return;
+        if (mapOwnerId == kInvalidEntityId)
+            mapOwnerId = tilemapEntityId;
+        for (const TileChangedBatch::Cell &cell : ev.cells)
+            createTileBody(*map, cell.x, cell.y, map->get(cell.x, cell.y), /*replace=*/true);
+        for (const TileChangedBatch::ChunkBounds &bounds : ev.chunks)
+            wakeBodiesAround(*map, bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
     }
 
     void handleBreak(const BreakBlockEvent &ev) {
-        auto it = tileBodies.find({ev.x, ev.y});
-        if (it != tileBodies.end()) {
-            if (it->second.body)
-                physicsManager.destroyBody(it->second.body);
-            tileBodies.erase(it);
-        }
-
         TilemapComponent *map = findTilemap();
         if (!map)
             return;
@@ -223,8 +379,8 @@ class PhysicsSystem : public System {
         if (tileId == map->emptyId)
             return;
 
-        wakeBodiesAroundTile(*map, ev.x, ev.y);
-        spawnDrop(*map, ev.x, ev.y, tileId);
+        if (const int itemId = map->registry.dropItem(tileId); itemId >= 0)
+            spawnDrop(*map, ev.x, ev.y, itemId);
     }
 
     void createTileBody(TilemapComponent &map, int x, int y, int tileId, bool replace = false) {
@@ -241,7 +397,7 @@ class PhysicsSystem : public System {
             tileBodies.erase(it);
         }
 
-        if (!map.isSolid(tileId))
+        if (!map.registry.solid(tileId))
             return;
 
         Vec2 center{map.origin.x + (static_cast<float>(x) + 0.5f) * map.tileSize,
@@ -255,12 +411,13 @@ class PhysicsSystem : public System {
         cfg.restitution = 0.0f;
         cfg.canRotate = false;
         cfg.isSensor = false;
+        cfg.layer = CollisionLayer::Tile;
 
         TileBody bodyInfo;
         bodyInfo.tag = std::make_unique<FixtureTag>();
         bodyInfo.tag->entityId = mapOwnerId == kInvalidEntityId ? 0 : mapOwnerId;
+        bodyInfo.tag->layer = CollisionLayer::Tile;
         bodyInfo.tag->isSensor = false;
-        bodyInfo.tag->isFootSensor = false;
 
         bodyInfo.body =
             physicsManager.createBody(b2_staticBody, center, 0.0f, false, 0.0f, 0.0f);
@@ -269,13 +426,13 @@ class PhysicsSystem : public System {
         tileBodies.emplace(key, std::move(bodyInfo));
     }
 
-    void wakeBodiesAroundTile(const TilemapComponent &map, int x, int y) {
-        Vec2 center{map.origin.x + (static_cast<float>(x) + 0.5f) * map.tileSize,
-                    map.origin.y - (static_cast<float>(y) + 0.5f) * map.tileSize};
-        const float half = map.tileSize * 0.5f;
+    // Wakes dynamic bodies touching tiles [x0, x1] x [y0, y1].
+    void wakeBodiesAround(const TilemapComponent &map, int x0, int y0, int x1, int y1) {
         const float margin = map.tileSize * 0.1f;
-        Vec2 wmin{center.x - half - margin, center.y - half - margin};
-        Vec2 wmax{center.x + half + margin, center.y + half + margin};
+        Vec2 wmin{map.origin.x + static_cast<float>(x0) * map.tileSize - margin,
+                  map.origin.y - static_cast<float>(y1 + 1) * map.tileSize - margin};
+        Vec2 wmax{map.origin.x + static_cast<float>(x1 + 1) * map.tileSize + margin,
+                  map.origin.y - static_cast<float>(y0) * map.tileSize + margin};
 
         b2AABB aabb;
         b2Vec2 pmin = worldToPhysics(wmin);
@@ -296,7 +453,7 @@ class PhysicsSystem : public System {
         physicsManager.getWorld().QueryAABB(&query, aabb);
     }
 
-    void spawnDrop(const TilemapComponent &map, int x, int y, int tileId) {
+    void spawnDrop(const TilemapComponent &map, int x, int y, int itemId) {
         Vec2 center{map.origin.x + (static_cast<float>(x) + 0.5f) * map.tileSize,
                     map.origin.y - (static_cast<float>(y) + 0.5f) * map.tileSize};
 
@@ -319,9 +476,10 @@ class PhysicsSystem : public System {
         body->fixture.angularDamping = 0.1f;  // slight damping
         body->fixture.canRotate = true;
         body->fixture.isSensor = false;
+        body->fixture.layer = CollisionLayer::Drop;
 
         auto *dropComp = drop.addComponent<DropComponent>();
-        dropComp->itemId = tileId;
+        dropComp->itemId = itemId;
         dropComp->count = 1;
 
         auto *sprite = drop.addComponent<SpriteComponent>();
@@ -332,10 +490,9 @@ class PhysicsSystem : public System {
         const float dropScale = map.tileSize / 3.0f; // render drops at 1/3 tile size
         sprite->scale = Vec2{dropScale, dropScale};
 
-        // Optionally reuse atlas region if provided.
-        auto itRegion = map.tileIdToRegion.find(tileId);
-        if (itRegion != map.tileIdToRegion.end()) {
-            sprite->atlasRegion = itRegion->second;
+        if (const RegionHandle region = dropRegionLookup ? dropRegionLookup(map, itemId) : kInvalidHandle;
+            region != kInvalidHandle) {
+            sprite->region = region;
             sprite->useTextureRect = false;
         }
 
@@ -350,6 +507,7 @@ class PhysicsSystem : public System {
     }
 
     void syncTransforms() {
+        const TilemapComponent *map = findTilemap();
         for (auto &entPtr : entityManager.all()) {
             auto *bodyComp = entPtr->get<PhysicsBodyComponent>();
             if (!bodyComp || !bodyComp->body)
@@ -359,17 +517,31 @@ class PhysicsSystem : public System {
             bodyComp->position = physicsToWorld(Vec2{pos.x, pos.y});
             bodyComp->angleDeg = physicsAngleToWorld(bodyComp->body->GetAngle());
 
+            // Bodies that moved (or were spawned) over a chunk that is not resident are parked right away.
+            if (map && bodyComp->body->GetType() == b2_dynamicBody && bodyComp->body->IsEnabled()) {
+                if (const auto chunk = chunkAt(*map, bodyComp->position); chunk && !map->tiles.find(*chunk))
+                    parkBody(entPtr->getId(), *bodyComp, *chunk);
+            }
+
             if (auto *transform = entPtr->get<TransformComponent>()) {
                 transform->position = bodyComp->position;
                 transform->rotationDeg = bodyComp->angleDeg;
             }
+
+            spatialIndex.update(entPtr->getId(), bodyComp->position,
+                                CollisionMatrix::categoryBit(bodyComp->fixture.layer));
         }
     }
 
     PhysicsManager &physicsManager;
     EntityManager &entityManager;
     EventBus &eventBus;
+    SpatialIndex &spatialIndex;
     ContactListener contactListener;
+    std::vector<std::function<bool(const Entity &)>> contactTagFilters;
+    DropRegionLookup dropRegionLookup;
+    int velocityIterations{PHYSICS_VELOCITY_ITER};
+    int positionIterations{PHYSICS_POSITION_ITER};
 
     struct TileBody {
         b2Body *body{nullptr};
@@ -384,6 +556,7 @@ class PhysicsSystem : public System {
     };
 
     std::unordered_map<std::pair<int, int>, TileBody, PairHash> tileBodies;
+    std::unordered_map<TileChunkStore::Key, std::vector<Entity::Id>> parkedBodies; // by chunk under the body
     bool tilemapInitialized{false};
     Entity::Id tilemapEntityId{static_cast<Entity::Id>(-1)};
     Entity::Id mapOwnerId{static_cast<Entity::Id>(-1)};
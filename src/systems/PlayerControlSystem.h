@@ -1,35 +1,24 @@
 #ifndef DDD_SYSTEMS_PLAYER_CONTROL_SYSTEM_H
 #define DDD_SYSTEMS_PLAYER_CONTROL_SYSTEM_H
 
-#include "components/GroundedComponent.h"
+#include "components/CharacterControllerComponent.h"
 #include "components/InputComponent.h"
-#include "components/PhysicsBodyComponent.h"
 #include "components/Tags.h"
-#include "components/TransformComponent.h"
 #include "core/EntityManager.h"
-#include "core/EventBus.h"
 #include "core/System.h"
-#include "events/PhysicsEvents.h"
 #include "systems/InputSystem.h"
-#include <unordered_set>
 
+// Feeds player input into the CharacterControllerComponent; speeds are set on the component at spawn.
 class PlayerControlSystem : public System {
   public:
-    PlayerControlSystem(InputSystem &inputSystem, EntityManager &entityManager, EventBus &eventBus, float moveSpeed,
-                        float jumpImpulse);
+    PlayerControlSystem(InputSystem &inputSystem, EntityManager &entityManager);
     ~PlayerControlSystem() override = default;
 
     void update(float dt) override;
 
   private:
-    void onGrounded(const GroundedEvent &ev);
-
     InputSystem &inputSystem;
     EntityManager &entityManager;
-    EventBus &eventBus;
-    float moveSpeed{6.0f};
-    float jumpImpulse{8.0f};
 };
 
 #endif // DDD_SYSTEMS_PLAYER_CONTROL_SYSTEM_H
-
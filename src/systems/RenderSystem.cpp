@@ -1,141 +1,462 @@
 #include "systems/RenderSystem.h"
 
+#include "components/DropComponent.h"
+#include "components/PhysicsBodyComponent.h"
+#include "components/Tags.h"
 #include "utils/Constants.h"
 #include "utils/CoordinateUtils.h"
 #include <algorithm>
+#include <cstdlib>
+#include <optional>
 
-RenderSystem::RenderSystem(WindowManager &windowMgr, CameraManager &cameraMgr, ResourceManager &resourceMgr, EntityManager &entityMgr)
-    : windowManager(windowMgr), cameraManager(cameraMgr), resourceManager(resourceMgr), entityManager(entityMgr) {}
+RenderSystem::RenderSystem(WindowManager &windowMgr, CameraManager &cameraMgr, ResourceManager &resourceMgr,
+                           EntityManager &entityMgr, EventBus &eventBus, SpatialIndex &spatialIdx)
+    : windowManager(windowMgr), cameraManager(cameraMgr), resourceManager(resourceMgr), entityManager(entityMgr),
+      spatialIndex(spatialIdx) {
+    eventBus.subscribe<TileChangedBatch>([this](const TileChangedBatch &ev) {
+        for (const TileChangedBatch::ChunkBounds &bounds : ev.chunks)
+            markTilesDirty(bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
+    });
+    eventBus.subscribe<ChunkLoadedEvent>(
+        [this](const ChunkLoadedEvent &ev) { markStorageChunkDirty(ev.chunkX, ev.chunkY); });
+    eventBus.subscribe<ChunkUnloadedEvent>(
+        [this](const ChunkUnloadedEvent &ev) { markStorageChunkDirty(ev.chunkX, ev.chunkY); });
+}
+
+// Render chunks never straddle storage chunks, so a patch is copied from a single resident chunk.
+static_assert(TileChunkStore::kChunkSize % TilemapChunkCache::kChunkSize == 0,
+              "storage chunks must be a multiple of render chunks");
 
 void RenderSystem::update(float dt) {
     (void)dt;
+    extract(syncSnapshot);
+    render(syncSnapshot, windowManager.getWindow());
+}
 
-    sf::RenderWindow &window = windowManager.getWindow();
-    updateView();
-    window.setView(windowManager.getView());
-    window.clear(clearColor);
+void RenderSystem::extract(RenderSnapshot &snapshot) {
+    snapshot.frame = ++frameCounter;
+    updateView(snapshot);
 
-    std::vector<TilemapDraw> tileDraws;
-    std::vector<SpriteDraw> spriteDraws;
-    tileDraws.reserve(entityManager.all().size());
-    spriteDraws.reserve(entityManager.all().size());
+    std::vector<MinimapMarker> &markers = snapshot.ui.minimapMarkers;
+    markers.clear();
+    std::optional<MinimapMarker> playerMarker;
 
-    for (auto &entPtr : entityManager.all()) {
-        const TransformComponent *transform = entPtr->get<TransformComponent>();
+    if (scene.version != entityManager.getVersion())
+        rebuildScene();
 
-        if (const auto *tilemap = entPtr->get<TilemapComponent>()) {
-            if (tilemap->visible) {
-                tileDraws.push_back(TilemapDraw{tilemap->z, entPtr->getId(), tilemap, transform});
-            }
+    if (scene.player) {
+        if (const auto *transform = scene.player->get<TransformComponent>())
+            playerMarker = MinimapMarker{{transform->position.x, transform->position.y}, MinimapMarker::Kind::Player};
+    }
+    for (Entity *drop : scene.drops) {
+        if (const auto *transform = drop->get<TransformComponent>())
+            markers.push_back({{transform->position.x, transform->position.y}, MinimapMarker::Kind::Drop});
+    }
+
+    renderQueue.beginFrame();
+    // Queue entries are keyed by entity, so a tilemap entity's sprite (if any) is not drawn.
+    for (Entity *entity : scene.tilemaps) {
+        const auto *tilemap = entity->get<TilemapComponent>();
+        if (!tilemap->visible)
+            continue;
+        RenderQueue::Item item;
+        item.id = entity->getId();
+        item.layer = RenderLayer::Tilemap;
+        item.z = tilemap->z;
+        item.tilemap = tilemap;
+        item.transform = entity->get<TransformComponent>();
+        renderQueue.submit(item, 0, true);
+    }
+
+    // Only sprites that can be on screen are submitted; the queue drops the rest at endFrame().
+    const auto submitSprite = [&](Entity &entity) {
+        auto *sprite = entity.get<SpriteComponent>();
+        RenderQueue::Item item;
+        if (!sprite || !sprite->visible || !resolveSpriteSource(*sprite, item.texture, item.textureRect))
+            return;
+        item.id = entity.getId();
+        item.layer = RenderLayer::Sprite;
+        item.z = sprite->z;
+        item.sprite = sprite;
+        item.transform = entity.get<TransformComponent>();
+        if (isSpriteVisible(item))
+            renderQueue.submit(item, renderQueue.textureId(item.texture), true);
+    };
+    // Sprites the spatial index does not track (yet) are culled one by one; bodies leave the list once indexed.
+    for (std::size_t i = 0; i < scene.unindexedSprites.size();) {
+        Entity *entity = scene.unindexedSprites[i];
+        if (entity->has<PhysicsBodyComponent>() && spatialIndex.contains(entity->getId())) {
+            scene.unindexedSprites[i] = scene.unindexedSprites.back();
+            scene.unindexedSprites.pop_back();
+            continue;
         }
+        submitSprite(*entity);
+        ++i;
+    }
 
-        if (const auto *sprite = entPtr->get<SpriteComponent>()) {
-            if (sprite->visible) {
-                spriteDraws.push_back(SpriteDraw{sprite->z, entPtr->getId(), sprite, transform});
-            }
+    // View rectangle in world units (world y points up, render y points down).
+    const Vec2 worldMin{visibleRect.left / RENDER_SCALE - kIndexedSpriteMargin,
+                        -(visibleRect.top + visibleRect.height) / RENDER_SCALE - kIndexedSpriteMargin};
+    const Vec2 worldMax{(visibleRect.left + visibleRect.width) / RENDER_SCALE + kIndexedSpriteMargin,
+                        -visibleRect.top / RENDER_SCALE + kIndexedSpriteMargin};
+    spatialIndex.queryAABB(worldMin, worldMax, SpatialIndex::kAllCategories, [&](Entity::Id id, const Vec2 &) {
+        Entity *entity = entityManager.find(id);
+        if (entity && !entity->has<TilemapComponent>())
+            submitSprite(*entity);
+    });
+    renderQueue.endFrame();
+    if (playerMarker)
+        markers.push_back(*playerMarker); // drawn last, on top of drops
+
+    // Feeds of tilemaps that were removed (map reload) are dropped so a new map starts from a fresh copy.
+    for (auto it = tilemapFeeds.begin(); it != tilemapFeeds.end();) {
+        const RenderQueue::Item *item = renderQueue.find(it->first);
+        it = (item && item->layer == RenderLayer::Tilemap) ? std::next(it) : tilemapFeeds.erase(it);
+    }
+
+    // Keys order tilemaps first, then sprites by z and texture, so the render side batches texture runs naturally.
+    const std::uint64_t acked = renderedFrame.load(std::memory_order_acquire);
+    std::size_t tilemapCount = 0;
+    snapshot.sprites.clear();
+    renderQueue.forEachVisible([&](const RenderQueue::Item &item) {
+        if (item.layer == RenderLayer::Tilemap) {
+            if (tilemapCount == snapshot.tilemaps.size())
+                snapshot.tilemaps.emplace_back();
+            extractTilemap(item, acked, snapshot.tilemaps[tilemapCount++]);
+            return;
+        }
+        snapshot.sprites.push_back(
+            SpriteInstance{item.texture, item.textureRect, spriteTransform(*item.sprite, item.transform), item.z});
+    });
+    snapshot.tilemaps.resize(tilemapCount);
+}
+
+void RenderSystem::extractTilemap(const RenderQueue::Item &item, std::uint64_t acked, TilemapInstance &instance) {
+    const TilemapComponent &tilemap = *item.tilemap;
+    TilemapFeed &feed = tilemapFeeds[item.id];
+    const bool layoutChanged = feed.reset && (feed.reset->tilemap.width != tilemap.width ||
+                                              feed.reset->tilemap.height != tilemap.height ||
+                                              feed.reset->tilemap.tileSize != tilemap.tileSize);
+    if (!feed.reset || feed.source != &tilemap || layoutChanged) {
+        auto reset = std::make_shared<TilemapReset>();
+        reset->tilemap = tilemap;
+        reset->sources = TileSources::resolve(tilemap, resourceManager);
+        feed.source = &tilemap;
+        feed.reset = std::move(reset);
+        feed.resetFrame = frameCounter;
+        feed.pending.clear();
+    }
+
+    const Vec2 transformPos = item.transform ? item.transform->position : Vec2{};
+    const Vec2 transformScale = item.transform ? item.transform->scale : Vec2{1.0f, 1.0f};
+    const Vec2 renderOrigin = worldToRender(tilemap.origin + transformPos);
+    instance.id = item.id;
+    instance.renderOrigin = {renderOrigin.x, renderOrigin.y};
+    instance.scale = {transformScale.x, transformScale.y};
+    instance.reset = feed.resetFrame > acked ? feed.reset : nullptr;
+
+    // Every unacknowledged chunk is re-copied from the live tiles, so a snapshot dropped by the triple buffer
+    // (latest wins) loses nothing: the next one carries the same chunks in their newest state.
+    feed.pending.erase(std::remove_if(feed.pending.begin(), feed.pending.end(),
+                                      [acked](const TilemapFeed::PendingChunk &c) { return c.frame <= acked; }),
+                       feed.pending.end());
+    instance.patches.resize(feed.pending.size());
+    for (std::size_t i = 0; i < feed.pending.size(); ++i) {
+        const TilemapFeed::PendingChunk &chunk = feed.pending[i];
+        TileChunkPatch &patch = instance.patches[i];
+        patch.chunkX = chunk.chunkX;
+        patch.chunkY = chunk.chunkY;
+        patch.tiles.clear();
+        const int x0 = chunk.chunkX * TilemapChunkCache::kChunkSize;
+        const int y0 = chunk.chunkY * TilemapChunkCache::kChunkSize;
+        const int x1 = std::min(x0 + TilemapChunkCache::kChunkSize, tilemap.width);
+        const int y1 = std::min(y0 + TilemapChunkCache::kChunkSize, tilemap.height);
+        const TileChunk *source = tilemap.tiles.find(TileChunkStore::keyForTile(x0, y0));
+        patch.resident = source != nullptr;
+        if (!source)
+            continue;
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x)
+                patch.tiles.push_back(source->get(TileChunkStore::localIndex(x, y)));
         }
     }
+}
 
-    const auto byZ = [](const auto &a, const auto &b) {
-        if (a.z == b.z)
-            return a.id < b.id;
-        return a.z < b.z;
-    };
-    std::sort(tileDraws.begin(), tileDraws.end(), byZ);
-    std::sort(spriteDraws.begin(), spriteDraws.end(), byZ);
+void RenderSystem::render(const RenderSnapshot &snapshot, sf::RenderTarget &target) {
+    target.setView(snapshot.view);
+    target.clear(clearColor);
 
-    for (const auto &cmd : tileDraws) {
-        drawTilemap(*cmd.tilemap, cmd.transform, window);
+    // Mirrors of tilemaps missing from the snapshot are dropped; their feeds were dropped by extract() as well.
+    for (auto it = tilemapMirrors.begin(); it != tilemapMirrors.end();) {
+        const bool live = std::any_of(snapshot.tilemaps.begin(), snapshot.tilemaps.end(),
+                                      [&](const TilemapInstance &inst) { return inst.id == it->first; });
+        it = live ? std::next(it) : tilemapMirrors.erase(it);
     }
 
-    for (const auto &cmd : spriteDraws) {
-        drawSprite(*cmd.sprite, cmd.transform, window);
+    for (const TilemapInstance &instance : snapshot.tilemaps) {
+        TilemapMirror &mirror = tilemapMirrors[instance.id];
+        const bool feedsMinimap = minimapEnabled && &instance == &snapshot.tilemaps.front();
+        Minimap *minimapFeed = feedsMinimap ? &minimap : nullptr;
+        const bool rebased = syncMirror(mirror, instance, minimapFeed);
+        if (minimapFeed && mirror.base && (rebased || minimapTilemap != instance.id)) {
+            minimap.reset(mirror.tilemap, mirror.base->sources);
+            minimapTilemap = instance.id;
+        }
+        drawTilemap(mirror, instance, snapshot, target);
     }
+    if (snapshot.tilemaps.empty() && minimapTilemap != kInvalidEntityId) {
+        minimap.clear();
+        minimapTilemap = kInvalidEntityId;
+    }
+
+    spriteBatch.begin(target);
+    for (const SpriteInstance &sprite : snapshot.sprites)
+        spriteBatch.draw(*sprite.texture, sprite.textureRect, sprite.transform, sprite.z);
+    spriteBatch.end();
+    drawParticles(snapshot, target);
+
+    renderedFrame.store(snapshot.frame, std::memory_order_release);
 }
 
-void RenderSystem::updateView() {
-    sf::View view = windowManager.getView();
+bool RenderSystem::syncMirror(TilemapMirror &mirror, const TilemapInstance &instance, Minimap *minimapFeed) {
+    bool rebased = false;
+    if (instance.reset && instance.reset != mirror.base) {
+        mirror.base = instance.reset;
+        mirror.tilemap = instance.reset->tilemap;
+        mirror.chunks.markAllDirty();
+        mirror.shader.markAllDirty();
+        rebased = true;
+    }
+    if (!mirror.base)
+        return rebased;
+
+    TilemapComponent &tilemap = mirror.tilemap;
+    for (const TileChunkPatch &patch : instance.patches) {
+        const int x0 = patch.chunkX * TilemapChunkCache::kChunkSize;
+        const int y0 = patch.chunkY * TilemapChunkCache::kChunkSize;
+        const int x1 = std::min(x0 + TilemapChunkCache::kChunkSize, tilemap.width);
+        const int y1 = std::min(y0 + TilemapChunkCache::kChunkSize, tilemap.height);
+        const int storageX = TileChunkStore::chunkCoord(x0);
+        const int storageY = TileChunkStore::chunkCoord(y0);
+        if (!patch.resident) {
+            // Streamed out: forget the tiles; the minimap keeps showing everything explored so far.
+            TileChunk *stale = tilemap.tiles.find(storageX, storageY);
+            if (!stale)
+                continue;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    if (!stale->set(TileChunkStore::localIndex(x, y), TileChunkStore::kNotResident))
+                        continue;
+                    mirror.chunks.markDirty(x, y);
+                    mirror.shader.markDirty(x, y);
+                }
+            }
+            if (stale->uniform(TileChunkStore::kNotResident))
+                tilemap.tiles.erase(storageX, storageY);
+            continue;
+        }
+        if (static_cast<int>(patch.tiles.size()) != std::max(0, x1 - x0) * std::max(0, y1 - y0))
+            continue;
+        TileChunk &target = tilemap.tiles.ensure(storageX, storageY, TileChunkStore::kNotResident);
+        // Bounding rectangle of the cells this patch actually changed, uploaded to the minimap in one go.
+        int changed = 0;
+        int minX = x1, minY = y1, maxX = x0 - 1, maxY = y0 - 1;
+        auto src = patch.tiles.begin();
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x, ++src) {
+                if (!target.set(TileChunkStore::localIndex(x, y), *src))
+                    continue; // patches are resent until acknowledged; most of them are already applied
+                mirror.chunks.markDirty(x, y);
+                mirror.shader.markDirty(x, y);
+                if (!minimapFeed)
+                    continue;
+                minimapFeed->paintTile(x, y, *src);
+                ++changed;
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+        }
+        if (changed > 0)
+            minimapFeed->upload(sf::IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1));
+    }
+    return rebased;
+}
+
+void RenderSystem::drawParticles(const RenderSnapshot &snapshot, sf::RenderTarget &target) {
+    const ParticleSnapshot &particles = snapshot.particles;
+    const sf::FloatRect &visible = snapshot.visibleRect;
+    particleVertices.clear();
+    particleVertices.reserve(particles.count() * 6);
+    for (std::size_t i = 0; i < particles.count(); ++i) {
+        // World (y up) -> render pixels (y down), as worldToRender.
+        const float cx = particles.x[i] * RENDER_SCALE;
+        const float cy = -particles.y[i] * RENDER_SCALE;
+        const float half = particles.size[i] * RENDER_SCALE * 0.5f;
+        if (cx + half < visible.left || cx - half > visible.left + visible.width || cy + half < visible.top ||
+            cy - half > visible.top + visible.height)
+            continue;
+        const sf::Color color = particles.color[i];
+        const sf::Vertex tl({cx - half, cy - half}, color);
+        const sf::Vertex tr({cx + half, cy - half}, color);
+        const sf::Vertex br({cx + half, cy + half}, color);
+        const sf::Vertex bl({cx - half, cy + half}, color);
+        particleVertices.insert(particleVertices.end(), {tl, tr, br, tl, br, bl});
+    }
+    if (!particleVertices.empty())
+        target.draw(particleVertices.data(), particleVertices.size(), sf::Triangles);
+}
+
+void RenderSystem::updateView(RenderSnapshot &snapshot) {
     const Vec2 renderCenter = worldToRender(cameraManager.getCenter());
     const Vec2 viewportSize = cameraManager.getViewportSize();
     const float zoom = cameraManager.getZoom();
 
+    const float width = viewportSize.x * zoom;
+    const float height = viewportSize.y * zoom;
+    sf::View view = windowManager.getView();
     view.setCenter(renderCenter.x, renderCenter.y);
-    view.setSize(viewportSize.x * zoom, viewportSize.y * zoom);
+    view.setSize(width, height);
     windowManager.setView(view);
-}
-
-void RenderSystem::drawTilemap(const TilemapComponent &tilemap, const TransformComponent *transform, sf::RenderWindow &window) {
-    if (tilemap.width <= 0 || tilemap.height <= 0 || tilemap.tiles.empty())
-        return;
 
-    const Vec2 transformPos = transform ? transform->position : Vec2{};
-    const Vec2 base = tilemap.origin + transformPos;
-    const Vec2 transformScale = transform ? transform->scale : Vec2{1.0f, 1.0f};
+    visibleRect = sf::FloatRect(renderCenter.x - width * 0.5f, renderCenter.y - height * 0.5f, width, height);
+    snapshot.view = view;
+    snapshot.visibleRect = visibleRect;
+    snapshot.zoom = zoom;
+}
 
-    for (int y = 0; y < tilemap.height; ++y) {
-        for (int x = 0; x < tilemap.width; ++x) {
-            const int tileId = tilemap.get(x, y);
-            if (tileId < 0)
-                continue;
+int RenderSystem::lodForZoom(float zoom) {
+    // Each level halves imposter resolution; level n kicks in once a tile covers <= 1/2^n of its texels on screen.
+    int lod = 0;
+    for (float threshold = 2.0f; zoom >= threshold && lod < TilemapChunkCache::kMaxLod; threshold *= 2.0f)
+        ++lod;
+    return lod;
+}
 
-            const auto regionIt = tilemap.tileIdToRegion.find(tileId);
-            if (regionIt == tilemap.tileIdToRegion.end())
-                continue;
-            const std::string &regionName = regionIt->second;
-            if (!resourceManager.hasAtlasRegion(regionName))
-                continue;
+void RenderSystem::markTilesDirty(int x0, int y0, int x1, int y1) {
+    if (x1 < 0 || y1 < 0)
+        return;
+    for (int cy = std::max(y0, 0) / TilemapChunkCache::kChunkSize; cy <= y1 / TilemapChunkCache::kChunkSize; ++cy) {
+        for (int cx = std::max(x0, 0) / TilemapChunkCache::kChunkSize; cx <= x1 / TilemapChunkCache::kChunkSize; ++cx)
+            markChunkDirty(cx, cy);
+    }
+}
 
-            const ResourceManager::AtlasRegion &region = resourceManager.getAtlasRegion(regionName);
-            if (!resourceManager.hasTexture(region.textureName))
-                continue;
+void RenderSystem::markStorageChunkDirty(int storageX, int storageY) {
+    constexpr int kPerStorage = TileChunkStore::kChunkSize / TilemapChunkCache::kChunkSize;
+    for (int y = 0; y < kPerStorage; ++y) {
+        for (int x = 0; x < kPerStorage; ++x)
+            markChunkDirty(storageX * kPerStorage + x, storageY * kPerStorage + y);
+    }
+}
 
-            sf::Sprite sprite;
-            sprite.setTexture(resourceManager.getTexture(region.textureName));
-            sprite.setTextureRect(region.rect);
+void RenderSystem::markChunkDirty(int chunkX, int chunkY) {
+    // Tile events carry no tilemap id; there is a single world map, so every feed gets the hint.
+    // Events are pumped before extract(), so the edit first ships with the next snapshot.
+    const int tileX = chunkX * TilemapChunkCache::kChunkSize;
+    const int tileY = chunkY * TilemapChunkCache::kChunkSize;
+    for (auto &[id, feed] : tilemapFeeds) {
+        if (!feed.reset || !feed.reset->tilemap.inBounds(tileX, tileY))
+            continue;
+        auto it = std::find_if(feed.pending.begin(), feed.pending.end(), [&](const TilemapFeed::PendingChunk &c) {
+            return c.chunkX == chunkX && c.chunkY == chunkY;
+        });
+        if (it == feed.pending.end())
+            feed.pending.push_back({chunkX, chunkY, frameCounter + 1});
+        else
+            it->frame = frameCounter + 1;
+    }
+}
 
-            const Vec2 worldPos{base.x + static_cast<float>(x) * tilemap.tileSize,
-                                base.y - static_cast<float>(y) * tilemap.tileSize};
-            const Vec2 renderPos = worldToRender(worldPos);
-            sprite.setPosition(renderPos.x, renderPos.y);
+void RenderSystem::drawTilemap(TilemapMirror &mirror, const TilemapInstance &instance,
+                               const RenderSnapshot &snapshot, sf::RenderTarget &target) {
+    const TilemapComponent &tilemap = mirror.tilemap;
+    if (!mirror.base || tilemap.width <= 0 || tilemap.height <= 0 || tilemap.tiles.empty())
+        return;
+    if (instance.scale.x <= 0.0f || instance.scale.y <= 0.0f)
+        return;
 
-            const float scaleX = (tilemap.tileSize * RENDER_SCALE) / static_cast<float>(region.rect.width);
-            const float scaleY = (tilemap.tileSize * RENDER_SCALE) / static_cast<float>(region.rect.height);
-            sprite.setScale(scaleX * transformScale.x, scaleY * transformScale.y);
+    // Chunk vertices are relative to the top-left corner of tile (0, 0).
+    sf::RenderStates states;
+    states.transform.translate(instance.renderOrigin.x, instance.renderOrigin.y);
+    states.transform.scale(instance.scale.x, instance.scale.y);
 
-            window.draw(sprite);
-        }
-    }
+    const sf::FloatRect &visible = snapshot.visibleRect;
+    const sf::FloatRect localVisible((visible.left - instance.renderOrigin.x) / instance.scale.x,
+                                     (visible.top - instance.renderOrigin.y) / instance.scale.y,
+                                     visible.width / instance.scale.x, visible.height / instance.scale.y);
+    const TileSources &sources = mirror.base->sources;
+    if (tilemapMode == TilemapRenderMode::Shader && mirror.shader.draw(tilemap, sources, target, states, localVisible))
+        return;
+    mirror.chunks.draw(tilemap, sources, target, states, localVisible, lodForZoom(snapshot.zoom));
 }
 
-void RenderSystem::drawSprite(const SpriteComponent &spriteComp, const TransformComponent *transform, sf::RenderWindow &window) {
-    const bool hasAtlas = !spriteComp.atlasRegion.empty() && resourceManager.hasAtlasRegion(spriteComp.atlasRegion);
-    const bool hasTexture = !spriteComp.textureName.empty() && resourceManager.hasTexture(spriteComp.textureName);
-    if (!hasAtlas && !hasTexture)
-        return;
+bool RenderSystem::resolveSpriteSource(SpriteComponent &spriteComp, const sf::Texture *&texture, sf::IntRect &rect) {
+    // Sprites spawned without handles get them interned once; afterwards the names are never hashed here.
+    if (spriteComp.region == kInvalidHandle && !spriteComp.atlasRegion.empty())
+        spriteComp.region = resourceManager.regionHandle(spriteComp.atlasRegion);
+    if (spriteComp.texture == kInvalidHandle && !spriteComp.textureName.empty())
+        spriteComp.texture = resourceManager.textureHandle(spriteComp.textureName);
 
-    sf::Sprite sprite;
-    if (hasAtlas) {
-        const auto &region = resourceManager.getAtlasRegion(spriteComp.atlasRegion);
-        if (!resourceManager.hasTexture(region.textureName))
-            return;
-        sprite.setTexture(resourceManager.getTexture(region.textureName));
-        sprite.setTextureRect(region.rect);
+    if (const ResourceManager::AtlasRegion *region = resourceManager.region(spriteComp.region)) {
+        texture = resourceManager.texture(region->texture);
+        rect = region->rect;
+        return texture != nullptr;
+    }
+    texture = resourceManager.texture(spriteComp.texture);
+    if (!texture)
+        return false;
+    // Textures packed into an atlas occupy `area` of the page; sprite rects stay relative to the source image.
+    const sf::IntRect area = resourceManager.textureArea(spriteComp.texture);
+    if (spriteComp.useTextureRect) {
+        rect = spriteComp.textureRect;
+        rect.left += area.left;
+        rect.top += area.top;
     } else {
-        sprite.setTexture(resourceManager.getTexture(spriteComp.textureName));
-        if (spriteComp.useTextureRect)
-            sprite.setTextureRect(spriteComp.textureRect);
+        rect = area;
     }
+    return true;
+}
 
+// Same composition as sf::Transformable: position * rotation * scale * -origin.
+sf::Transform RenderSystem::spriteTransform(const SpriteComponent &spriteComp,
+                                            const TransformComponent *transform) const {
+    sf::Transform xf;
     if (transform) {
         const Vec2 renderPos = worldToRender(transform->position);
-        sprite.setPosition(renderPos.x, renderPos.y);
-        sprite.setRotation(worldAngleToRender(transform->rotationDeg));
-        sprite.setScale(transform->scale.x * spriteComp.scale.x, transform->scale.y * spriteComp.scale.y);
+        xf.translate(renderPos.x, renderPos.y);
+        xf.rotate(worldAngleToRender(transform->rotationDeg));
+        xf.scale(transform->scale.x * spriteComp.scale.x, transform->scale.y * spriteComp.scale.y);
     } else {
-        sprite.setScale(spriteComp.scale.x, spriteComp.scale.y);
+        xf.scale(spriteComp.scale.x, spriteComp.scale.y);
     }
+    xf.translate(-spriteComp.origin.x, -spriteComp.origin.y);
+    return xf;
+}
 
-    sprite.setOrigin(spriteComp.origin.x, spriteComp.origin.y);
-    window.draw(sprite);
+void RenderSystem::rebuildScene() {
+    scene.tilemaps.clear();
+    scene.unindexedSprites.clear();
+    scene.drops.clear();
+    scene.player = nullptr;
+    for (auto &entPtr : entityManager.all()) {
+        Entity *entity = entPtr.get();
+        if (!scene.player && entity->has<PlayerTag>())
+            scene.player = entity;
+        else if (entity->has<DropComponent>())
+            scene.drops.push_back(entity);
+
+        if (entity->has<TilemapComponent>())
+            scene.tilemaps.push_back(entity);
+        else if (entity->has<SpriteComponent>() && !spatialIndex.contains(entity->getId()))
+            scene.unindexedSprites.push_back(entity);
+    }
+    scene.version = entityManager.getVersion();
 }
 
+bool RenderSystem::isSpriteVisible(const RenderQueue::Item &item) const {
+    const sf::FloatRect local(0.0f, 0.0f, static_cast<float>(std::abs(item.textureRect.width)),
+                              static_cast<float>(std::abs(item.textureRect.height)));
+    return spriteTransform(*item.sprite, item.transform).transformRect(local).intersects(visibleRect);
+}
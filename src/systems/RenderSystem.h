@@ -4,44 +4,133 @@
 #include "core/System.h"
 #include "managers/CameraManager.h"
 #include "managers/ResourceManager.h"
+#include "managers/SpatialIndex.h"
 #include "managers/WindowManager.h"
 #include "core/EntityManager.h"
+#include "core/EventBus.h"
 #include "components/SpriteComponent.h"
 #include "components/TilemapComponent.h"
 #include "components/TransformComponent.h"
+#include "events/TileEvents.h"
+#include "render/Minimap.h"
+#include "render/RenderQueue.h"
+#include "render/RenderSnapshot.h"
+#include "render/SpriteBatch.h"
+#include "render/TilemapChunkCache.h"
+#include "render/TilemapShaderRenderer.h"
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
+enum class TilemapRenderMode { Chunks, Shader };
+
+// World rendering in two halves: extract() runs on the simulation thread and fills a RenderSnapshot from the ECS
+// (view, culled sprite instances, tilemap copies and dirty chunks); render() draws a snapshot and touches nothing
+// but render-side state, so it may run on a dedicated render thread. update() does both back to back.
 class RenderSystem : public System {
   public:
-    RenderSystem(WindowManager &windowMgr, CameraManager &cameraMgr, ResourceManager &resourceMgr, EntityManager &entityMgr);
+    RenderSystem(WindowManager &windowMgr, CameraManager &cameraMgr, ResourceManager &resourceMgr, EntityManager &entityMgr,
+                 EventBus &eventBus, SpatialIndex &spatialIdx);
     void update(float dt) override;
 
+    void extract(RenderSnapshot &snapshot);
+    // Clears the target and draws the world; acknowledges snapshot.frame to extract() once done.
+    void render(const RenderSnapshot &snapshot, sf::RenderTarget &target);
+
+    // Shader mode falls back to chunks per tilemap when the GPU path is unavailable or the map is not eligible.
+    // Set before rendering starts; the render thread reads it unsynchronized.
+    void setTilemapMode(TilemapRenderMode mode) { tilemapMode = mode; }
+    TilemapRenderMode getTilemapMode() const { return tilemapMode; }
+
+    // Render side: overview of the first drawn tilemap, kept in sync with the same chunk patches as the world.
+    // Set before rendering starts, like the tilemap mode.
+    void setMinimapEnabled(bool enabled) { minimapEnabled = enabled; }
+    const Minimap &getMinimap() const { return minimap; }
+
   private:
-    struct SpriteDraw {
-        int z{0};
-        Entity::Id id{0};
-        const SpriteComponent *sprite{nullptr};
-        const TransformComponent *transform{nullptr};
+    // Indexed entities are fetched from the spatial index with this margin (world units) around the view,
+    // then culled by their real bounds; sprites larger than this around their position may pop at the edges.
+    static constexpr float kIndexedSpriteMargin = 4.0f;
+
+    // Simulation side: what the render side has been sent for one tilemap entity.
+    struct TilemapFeed {
+        struct PendingChunk {
+            int chunkX{0};
+            int chunkY{0};
+            std::uint64_t frame{0}; // first snapshot that carries the edit
+        };
+
+        const TilemapComponent *source{nullptr};
+        std::shared_ptr<const TilemapReset> reset;
+        std::uint64_t resetFrame{0};
+        std::vector<PendingChunk> pending; // resent every frame until the render side has drawn `frame`
     };
 
-    struct TilemapDraw {
-        int z{0};
-        Entity::Id id{0};
-        const TilemapComponent *tilemap{nullptr};
-        const TransformComponent *transform{nullptr};
+    // Render side: patched copy of the tilemap and its GPU caches.
+    struct TilemapMirror {
+        std::shared_ptr<const TilemapReset> base;
+        TilemapComponent tilemap;
+        TilemapChunkCache chunks;
+        TilemapShaderRenderer shader;
     };
 
-    void updateView();
-    void drawTilemap(const TilemapComponent &tilemap, const TransformComponent *transform, sf::RenderWindow &window);
-    void drawSprite(const SpriteComponent &spriteComp, const TransformComponent *transform, sf::RenderWindow &window);
+    // Simulation side: entities extract() needs, gathered only when EntityManager::getVersion() changes.
+    // Sprites tracked by the spatial index are not listed; they are found through the view query.
+    struct SceneCache {
+        std::uint64_t version{~0ull};
+        std::vector<Entity *> tilemaps;
+        std::vector<Entity *> unindexedSprites; // no physics body, or not indexed yet
+        std::vector<Entity *> drops;            // minimap markers
+        Entity *player{nullptr};
+    };
+
+    void rebuildScene();
+    void updateView(RenderSnapshot &snapshot);
+    bool resolveSpriteSource(SpriteComponent &spriteComp, const sf::Texture *&texture, sf::IntRect &rect);
+    sf::Transform spriteTransform(const SpriteComponent &spriteComp, const TransformComponent *transform) const;
+    bool isSpriteVisible(const RenderQueue::Item &item) const;
+    void extractTilemap(const RenderQueue::Item &item, std::uint64_t acked, TilemapInstance &instance);
+    // Returns true when the mirror was replaced by a new copy; tile edits are forwarded to `minimapFeed`.
+    bool syncMirror(TilemapMirror &mirror, const TilemapInstance &instance, Minimap *minimapFeed);
+    void drawTilemap(TilemapMirror &mirror, const TilemapInstance &instance, const RenderSnapshot &snapshot,
+                     sf::RenderTarget &target);
+    void drawParticles(const RenderSnapshot &snapshot, sf::RenderTarget &target);
+    void markTilesDirty(int x0, int y0, int x1, int y1); // inclusive tile bounds
+    void markChunkDirty(int chunkX, int chunkY);
+    void markStorageChunkDirty(int storageX, int storageY);
+    static int lodForZoom(float zoom);
 
     WindowManager &windowManager;
     CameraManager &cameraManager;
     ResourceManager &resourceManager;
     EntityManager &entityManager;
+    SpatialIndex &spatialIndex;
+
+    // Simulation side.
+    sf::FloatRect visibleRect; // render pixels, refreshed by updateView()
+    RenderQueue renderQueue;
+    SceneCache scene;
+    std::uint64_t frameCounter{0};
+    std::unordered_map<Entity::Id, TilemapFeed> tilemapFeeds; // pruned when the tilemap is not drawn
+    RenderSnapshot syncSnapshot; // used by update()
+
+    // Shared: last frame render() finished.
+    std::atomic<std::uint64_t> renderedFrame{0};
+
+    // Render side.
+    SpriteBatch spriteBatch;
+    std::vector<sf::Vertex> particleVertices; // reused between frames
+    TilemapRenderMode tilemapMode{TilemapRenderMode::Chunks};
+    std::unordered_map<Entity::Id, TilemapMirror> tilemapMirrors; // same lifetime as the snapshot's tilemaps
+    bool minimapEnabled{true};
+    Minimap minimap;
+    Entity::Id minimapTilemap{kInvalidEntityId}; // tilemap the minimap was built from
 
     sf::Color clearColor{sf::Color::Black};
+    static constexpr Entity::Id kInvalidEntityId = static_cast<Entity::Id>(-1);
 };
 
 #endif // DDD_SYSTEMS_RENDER_SYSTEM_H
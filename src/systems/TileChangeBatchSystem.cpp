@@ -0,0 +1,45 @@
+#include "systems/TileChangeBatchSystem.h"
+
+#include "components/TilemapComponent.h"
+#include <algorithm>
+
+TileChangeBatchSystem::TileChangeBatchSystem(EntityManager &entityMgr, EventBus &eventBus)
+    : entityManager(entityMgr), eventBus(eventBus) {}
+
+void TileChangeBatchSystem::update(float dt) {
+    (void)dt;
+
+    TilemapComponent *tilemap = nullptr;
+    for (auto &entPtr : entityManager.all()) {
+        tilemap = entPtr->get<TilemapComponent>();
+        if (tilemap)
+            break;
+    }
+    if (!tilemap)
+        return;
+    tilemap->tiles.takeFrameEdits(frameEdits);
+    if (frameEdits.empty())
+        return;
+
+    TileChangedBatch batch;
+    batch.cells.reserve(frameEdits.size());
+    chunkIndex.clear();
+    for (const TileJournal::Entry &e : frameEdits.all()) {
+        if (e.before == e.after)
+            continue; // edited and restored within the frame
+        batch.cells.push_back({e.x, e.y, e.before, e.after});
+        const TileChunkStore::Key key = TileChunkStore::keyForTile(e.x, e.y);
+        const auto [it, inserted] = chunkIndex.try_emplace(key, batch.chunks.size());
+        if (inserted) {
+            batch.chunks.push_back({TileChunkStore::keyX(key), TileChunkStore::keyY(key), e.x, e.y, e.x, e.y});
+            continue;
+        }
+        TileChangedBatch::ChunkBounds &bounds = batch.chunks[it->second];
+        bounds.minX = std::min(bounds.minX, e.x);
+        bounds.minY = std::min(bounds.minY, e.y);
+        bounds.maxX = std::max(bounds.maxX, e.x);
+        bounds.maxY = std::max(bounds.maxY, e.y);
+    }
+    if (!batch.cells.empty())
+        eventBus.emit(batch);
+}
@@ -0,0 +1,27 @@
+#ifndef DDD_SYSTEMS_TILE_CHANGE_BATCH_SYSTEM_H
+#define DDD_SYSTEMS_TILE_CHANGE_BATCH_SYSTEM_H
+
+#include "core/EntityManager.h"
+#include "core/EventBus.h"
+#include "core/System.h"
+#include "events/TileEvents.h"
+#include "utils/TileChunkStore.h"
+#include "utils/TileJournal.h"
+#include <cstddef>
+#include <unordered_map>
+
+// Publishes the frame's tile edits as one TileChangedBatch. Runs after every system that edits tiles.
+class TileChangeBatchSystem : public System {
+  public:
+    TileChangeBatchSystem(EntityManager &entityMgr, EventBus &eventBus);
+    void update(float dt) override;
+
+  private:
+    EntityManager &entityManager;
+    EventBus &eventBus;
+
+    TileJournal frameEdits; // reused between frames
+    std::unordered_map<TileChunkStore::Key, std::size_t> chunkIndex;
+};
+
+#endif // DDD_SYSTEMS_TILE_CHANGE_BATCH_SYSTEM_H
@@ -57,8 +57,13 @@ void TileInteractionSystem::update(float dt) {
 
     const int current = tilemap->get(tx, ty);
 
+    if (!tilemap->isResident(tx, ty))
+        return; // streamed out; nothing to edit until it is loaded again
+
     if (wantBreak && current != tilemap->emptyId) {
-        tilemap->tiles[tilemap->index(tx, ty)] = tilemap->emptyId;
+        if (!tilemap->registry.breakable(current))
+            return;
+        tilemap->set(tx, ty, tilemap->emptyId);
         eventBus.emit(BreakBlockEvent{tx, ty, current});
     } else if (wantPlace && current == tilemap->emptyId) {
         int chosenTileId = placeTileFallback;
@@ -71,7 +76,7 @@ void TileInteractionSystem::update(float dt) {
             chosenTileId = activeItem->placeTileId;
         }
 
-        tilemap->tiles[tilemap->index(tx, ty)] = chosenTileId;
+        tilemap->set(tx, ty, chosenTileId);
         eventBus.emit(PlaceBlockEvent{tx, ty, chosenTileId});
 
         if (inventorySystem && activeItem) {
@@ -1,8 +1,11 @@
 #include "systems/UIRenderSystem.h"
 
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
+
+namespace {
+const sf::Color kTextOutline(0, 0, 0, 140);
+}
 
 UIRenderSystem::UIRenderSystem(WindowManager &windowMgr, ResourceManager &resourceMgr, DebugManager &debugMgr, EventBus &eventBus)
     : windowManager(windowMgr), resourceManager(resourceMgr), debugManager(debugMgr), eventBus(eventBus) {
@@ -12,59 +15,100 @@ UIRenderSystem::UIRenderSystem(WindowManager &windowMgr, ResourceManager &resour
 
 void UIRenderSystem::update(float dt) {
     sf::RenderWindow &window = windowManager.getWindow();
-    window.setView(window.getDefaultView());
-
-    drawInventoryUI();
-    drawMenuButton();
-    drawMenuUI();
-    drawDebugOverlay(dt);
+    extract(syncSnapshot, dt);
+    render(syncSnapshot, window);
     window.display();
 }
 
-void UIRenderSystem::drawDebugOverlay(float dt) {
-    if (!debugManager.isVisible())
-        return;
-    if (!resourceManager.hasFont(debugFontName))
-        return;
+void UIRenderSystem::extract(UISnapshot &snapshot, float dt) {
+    snapshot.dt = dt;
+    static const MenuRenderState kNoMenu;
+    const MenuRenderState &menu = menuState ? *menuState : kNoMenu;
+    if (menu != lastMenu) {
+        lastMenu = menu;
+        ++menuVersion;
+    }
+    snapshot.menuVersion = menuVersion;
+    snapshot.menu = lastMenu;
+
+    // Snapshots are reused, so one already carrying this version holds these slots.
+    if (snapshot.inventoryVersion != inventoryVersion) {
+        snapshot.inventoryVersion = inventoryVersion;
+        snapshot.hasInventory = hasInventory;
+        snapshot.activeIndex = activeIndex;
+        snapshot.slots = slots;
+    }
 
-    sf::RenderWindow &window = windowManager.getWindow();
+    std::vector<std::string> &lines = snapshot.debugLines;
+    snapshot.debugVisible = debugManager.isVisible();
+    if (!snapshot.debugVisible) {
+        lines.clear();
+        return;
+    }
 
-    std::vector<std::string> lines;
-    lines.reserve(16);
+    // Lines are written into the snapshot's existing strings so steady-state frames do not allocate.
+    std::size_t count = 0;
+    const auto nextLine = [&]() -> std::string & {
+        if (count == lines.size())
+            lines.emplace_back();
+        return lines[count++];
+    };
 
-    std::ostringstream fpss;
-    fpss.setf(std::ios::fixed);
-    fpss << std::setprecision(1);
-    const float fps = dt > 0.0001f ? 1.0f / dt : 0.0f;
-    fpss << "FPS: " << fps;
-    lines.push_back(fpss.str());
+    char fps[32];
+    std::snprintf(fps, sizeof(fps), "FPS: %.1f", dt > 0.0001f ? 1.0f / dt : 0.0f);
+    nextLine().assign(fps);
 
     const auto &streams = debugManager.getStreams();
     if (!streams.empty()) {
         for (const auto &kv : streams) {
-            lines.push_back(kv.first + ":");
-            for (const auto &ln : kv.second) {
-                lines.push_back("  " + ln);
-            }
+            nextLine().assign(kv.first).append(":");
+            for (const auto &ln : kv.second)
+                nextLine().assign("  ").append(ln);
         }
     } else {
         const std::string &debugStr = debugManager.getString();
         if (!debugStr.empty())
-            lines.push_back(debugStr);
+            nextLine().assign(debugStr);
     }
+    lines.resize(count);
+}
+
+void UIRenderSystem::render(const UISnapshot &snapshot, sf::RenderTarget &target) {
+    target.setView(target.getDefaultView());
+
+    // Both versions only grow, so their sum changes whenever either does.
+    hudLayer.render(target, snapshot.inventoryVersion + snapshot.menuVersion, [&](sf::RenderTarget &layer) {
+        drawInventoryUI(snapshot, layer);
+        drawMenuButton(snapshot, layer);
+    });
+    drawMinimap(snapshot, target);
+    if (snapshot.menu.visible)
+        menuLayer.render(target, snapshot.menuVersion, [&](sf::RenderTarget &layer) { drawMenuUI(snapshot, layer); });
+    drawDebugOverlay(snapshot, target);
+    textCache.endFrame();
+}
+
+void UIRenderSystem::drawDebugOverlay(const UISnapshot &snapshot, sf::RenderTarget &target) {
+    if (!snapshot.debugVisible || snapshot.debugLines.empty())
+        return;
+    if (!resourceManager.hasFont(debugFontName))
+        return;
 
+    const std::vector<std::string> &lines = snapshot.debugLines;
     sf::Font &font = resourceManager.getFont(debugFontName);
     const unsigned int size = debugCharacterSize;
 
+    // Layouts come from the cache, so only lines whose text changed (typically FPS) are laid out again.
     float maxWidth = 0.0f;
-    sf::Text measure;
-    measure.setFont(font);
-    measure.setCharacterSize(size);
+    textBatch.clear();
+    const float lineHeight = static_cast<float>(size) + 4.0f;
+    float y = 12.0f;
     for (const auto &ln : lines) {
-        measure.setString(ln);
-        maxWidth = std::max(maxWidth, measure.getLocalBounds().width);
+        const TextLayout &layout = textCache.layout(font, size, ln);
+        maxWidth = std::max(maxWidth, layout.bounds.width);
+        textBatch.add(layout, {14.0f, y}, debugTextColor);
+        y += lineHeight;
     }
-    const float lineHeight = static_cast<float>(size) + 4.0f;
     const float height = lineHeight * static_cast<float>(lines.size()) + 12.0f;
     const float width = maxWidth + 16.0f;
 
@@ -74,65 +118,60 @@ void UIRenderSystem::drawDebugOverlay(float dt) {
     bg.setFillColor(sf::Color(0, 0, 0, 140));
     bg.setOutlineThickness(1.0f);
     bg.setOutlineColor(sf::Color(80, 80, 80, 180));
-    window.draw(bg);
-
-    sf::Text text;
-    text.setFont(font);
-    text.setCharacterSize(size);
-    text.setFillColor(debugTextColor);
-
-    float y = 12.0f;
-    for (const auto &ln : lines) {
-        text.setString(ln);
-        text.setPosition(14.0f, y);
-        window.draw(text);
-        y += lineHeight;
-    }
+    target.draw(bg);
+    textBatch.draw(target);
 }
 
-void UIRenderSystem::drawMenuButton() {
-    if (!menuState || !menuState->showMenuButton)
+void UIRenderSystem::drawMenuButton(const UISnapshot &snapshot, sf::RenderTarget &target) {
+    const MenuRenderState *menuState = &snapshot.menu;
+    if (!menuState->showMenuButton)
         return;
-    sf::RenderWindow &window = windowManager.getWindow();
     sf::RectangleShape rect;
     rect.setPosition(menuState->menuButtonRect.left, menuState->menuButtonRect.top);
     rect.setSize({menuState->menuButtonRect.width, menuState->menuButtonRect.height});
     rect.setFillColor(sf::Color(60, 72, 85, 230));
     rect.setOutlineThickness(2.5f);
     rect.setOutlineColor(sf::Color(120, 150, 190));
-    window.draw(rect);
+    target.draw(rect);
 
     sf::Font *font = resourceManager.hasFont(debugFontName) ? &resourceManager.getFont(debugFontName) : nullptr;
     if (font) {
-        sf::Text text;
-        text.setFont(*font);
-        text.setString("Menu");
-        text.setCharacterSize(18);
-        text.setFillColor(sf::Color::White);
-        text.setOutlineThickness(1.0f);
-        text.setOutlineColor(sf::Color(0, 0, 0, 140));
-        text.setPosition(menuState->menuButtonRect.left + 10.0f, menuState->menuButtonRect.top + 6.0f);
-        window.draw(text);
+        textBatch.clear();
+        textBatch.add(textCache.layout(*font, 18, "Menu", 1.0f),
+                      {menuState->menuButtonRect.left + 10.0f, menuState->menuButtonRect.top + 6.0f}, sf::Color::White,
+                      kTextOutline);
+        textBatch.draw(target);
     }
 }
 
+void UIRenderSystem::drawMinimap(const UISnapshot &snapshot, sf::RenderTarget &target) {
+    if (!minimap || !minimap->isReady() || snapshot.menu.visible)
+        return;
+    const float margin = 12.0f;
+    const float width = std::min(240.0f, static_cast<float>(target.getSize().x) * 0.3f);
+    const float height = width * 0.6f;
+    const sf::FloatRect frame(static_cast<float>(target.getSize().x) - width - margin, margin, width, height);
+    minimap->draw(target, frame, snapshot.minimapMarkers);
+}
+
 void UIRenderSystem::drawDebugButton() {
     // Debug button disabled per latest requirements (use key toggle instead).
 }
 
-void UIRenderSystem::drawMenuUI() {
-    if (!menuState || !menuState->visible)
+void UIRenderSystem::drawMenuUI(const UISnapshot &snapshot, sf::RenderTarget &target) {
+    const MenuRenderState *menuState = &snapshot.menu;
+    if (!menuState->visible)
         return;
-    sf::RenderWindow &window = windowManager.getWindow();
 
     const sf::Color overlay(20, 25, 32, 180);
     sf::RectangleShape bg;
-    bg.setSize(sf::Vector2f(static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y)));
+    bg.setSize(sf::Vector2f(static_cast<float>(target.getSize().x), static_cast<float>(target.getSize().y)));
     bg.setFillColor(overlay);
-    window.draw(bg);
+    target.draw(bg);
 
     sf::Font *font = resourceManager.hasFont(debugFontName) ? &resourceManager.getFont(debugFontName) : nullptr;
 
+    textBatch.clear();
     for (const auto &btn : menuState->buttons) {
         sf::RectangleShape rect;
         rect.setPosition(btn.rect.left, btn.rect.top);
@@ -140,47 +179,34 @@ void UIRenderSystem::drawMenuUI() {
         rect.setFillColor(btn.focused ? sf::Color(70, 90, 110, 220) : sf::Color(44, 52, 60, 220));
         rect.setOutlineThickness(2.0f);
         rect.setOutlineColor(btn.focused ? sf::Color(111, 163, 216) : sf::Color(74, 85, 96));
-        window.draw(rect);
+        target.draw(rect);
 
         if (font) {
-            sf::Text text;
-            text.setFont(*font);
-            text.setString(btn.label);
-            text.setCharacterSize(18);
-            text.setFillColor(sf::Color::White);
-            text.setOutlineThickness(1.0f);
-            text.setOutlineColor(sf::Color(0, 0, 0, 140));
+            const TextLayout &layout = textCache.layout(*font, 18, btn.label, 1.0f);
             const float tx = btn.rect.left + 12.0f;
-            const float ty = btn.rect.top + (btn.rect.height - text.getLocalBounds().height) * 0.5f - 6.0f;
-            text.setPosition(tx, ty);
-            window.draw(text);
+            const float ty = btn.rect.top + (btn.rect.height - layout.bounds.height) * 0.5f - 6.0f;
+            textBatch.add(layout, {tx, ty}, sf::Color::White, kTextOutline);
         }
     }
 
     if (font && menuState->screen == MenuScreen::Settings) {
         float y = menuState->buttons.empty() ? 120.0f : menuState->buttons.back().rect.top + 60.0f;
         for (const auto &line : menuState->settingsLines) {
-            sf::Text t;
-            t.setFont(*font);
-            t.setCharacterSize(16);
-            t.setFillColor(sf::Color::White);
-            t.setString(line);
-            t.setPosition(80.0f, y);
-            t.setOutlineThickness(1.0f);
-            t.setOutlineColor(sf::Color(0, 0, 0, 140));
-            window.draw(t);
+            textBatch.add(textCache.layout(*font, 16, line, 1.0f), {80.0f, y}, sf::Color::White, kTextOutline);
             y += 22.0f;
         }
     }
+    textBatch.draw(target);
 }
 
-void UIRenderSystem::drawInventoryUI() {
-    if (!hasInventory)
+void UIRenderSystem::drawInventoryUI(const UISnapshot &snapshot, sf::RenderTarget &target) {
+    if (!snapshot.hasInventory)
         return;
-    if (menuState && menuState->visible)
+    if (snapshot.menu.visible)
         return;
 
-    sf::RenderWindow &window = windowManager.getWindow();
+    const std::vector<UISnapshot::Slot> &slots = snapshot.slots;
+    const int activeIndex = snapshot.activeIndex;
     const int slotCount = static_cast<int>(slots.size());
     if (slotCount <= 0)
         return;
@@ -188,8 +214,8 @@ void UIRenderSystem::drawInventoryUI() {
     const float slotSize = 48.0f;
     const float slotPad = 6.0f;
     const float barWidth = slotCount * slotSize + (slotCount - 1) * slotPad;
-    const float xStart = 0.5f * (window.getSize().x - barWidth);
-    const float y = static_cast<float>(window.getSize().y) - slotSize - 20.0f;
+    const float xStart = 0.5f * (target.getSize().x - barWidth);
+    const float y = static_cast<float>(target.getSize().y) - slotSize - 20.0f;
 
     sf::RectangleShape rect;
     rect.setSize({slotSize, slotSize});
@@ -203,30 +229,28 @@ void UIRenderSystem::drawInventoryUI() {
         font = &resourceManager.getFont(debugFontName);
     }
 
+    textBatch.clear();
     for (int i = 0; i < slotCount; ++i) {
         const float x = xStart + i * (slotSize + slotPad);
-        const UISlot &slot = slots[i];
+        const UISnapshot::Slot &slot = slots[i];
 
         rect.setPosition(x, y);
         rect.setFillColor(slotFill);
         rect.setOutlineThickness(2.0f);
         rect.setOutlineColor(i == activeIndex ? activeBorder : slotBorder);
-        window.draw(rect);
+        target.draw(rect);
 
         // Icon rendering
         bool iconDrawn = false;
-        if (!slot.iconRegion.empty() && resourceManager.hasAtlasRegion(slot.iconRegion)) {
-            const auto &region = resourceManager.getAtlasRegion(slot.iconRegion);
-            if (resourceManager.hasTexture(region.textureName)) {
-                sf::Sprite sprite;
-                sprite.setTexture(resourceManager.getTexture(region.textureName));
-                sprite.setTextureRect(region.rect);
-                const float scale = slotSize / static_cast<float>(std::max(region.rect.width, region.rect.height));
-                sprite.setScale(scale, scale);
-                sprite.setPosition(x + 4.0f, y + 4.0f);
-                window.draw(sprite);
-                iconDrawn = true;
-            }
+        if (slot.iconTexture) {
+            sf::Sprite sprite;
+            sprite.setTexture(*slot.iconTexture);
+            sprite.setTextureRect(slot.iconRect);
+            const float scale = slotSize / static_cast<float>(std::max(slot.iconRect.width, slot.iconRect.height));
+            sprite.setScale(scale, scale);
+            sprite.setPosition(x + 4.0f, y + 4.0f);
+            target.draw(sprite);
+            iconDrawn = true;
         }
 
         if (!iconDrawn && slot.itemId >= 0) {
@@ -234,73 +258,60 @@ void UIRenderSystem::drawInventoryUI() {
             icon.setSize({slotSize - 8.0f, slotSize - 8.0f});
             icon.setPosition(x + 4.0f, y + 4.0f);
             icon.setFillColor(sf::Color(70, 90, 110, 210));
-            window.draw(icon);
+            target.draw(icon);
         }
 
         if (font) {
+            const sf::Color outline(0, 0, 0, 160);
             // Item label
-            sf::Text label;
-            label.setFont(*font);
-            label.setCharacterSize(12);
-            label.setFillColor(sf::Color::White);
-            label.setOutlineThickness(1.0f);
-            label.setOutlineColor(sf::Color(0, 0, 0, 160));
             if (slot.itemId >= 0) {
-                label.setString("ID " + std::to_string(slot.itemId));
-                label.setPosition(x + 6.0f, y + 6.0f);
-                window.draw(label);
+                const TextLayout &label = textCache.layout(*font, 12, "ID " + std::to_string(slot.itemId), 1.0f);
+                textBatch.add(label, {x + 6.0f, y + 6.0f}, sf::Color::White, outline);
             }
 
             // Quantity
             if (slot.count > 0) {
-                sf::Text qty;
-                qty.setFont(*font);
-                qty.setCharacterSize(14);
-                qty.setFillColor(sf::Color::White);
-                qty.setOutlineThickness(1.0f);
-                qty.setOutlineColor(sf::Color(0, 0, 0, 160));
-                qty.setString(std::to_string(slot.count));
-                qty.setPosition(x + slotSize - 6.0f - qty.getLocalBounds().width, y + slotSize - 22.0f);
-                window.draw(qty);
+                const TextLayout &qty = textCache.layout(*font, 14, std::to_string(slot.count), 1.0f);
+                textBatch.add(qty, {x + slotSize - 6.0f - qty.bounds.width, y + slotSize - 22.0f}, sf::Color::White,
+                              outline);
             }
         }
     }
 
     // Active item info
     if (font && activeIndex >= 0 && activeIndex < slotCount) {
-        const UISlot &slot = slots[activeIndex];
+        const UISnapshot::Slot &slot = slots[activeIndex];
         if (slot.itemId >= 0 && slot.count > 0) {
-            sf::Text info;
-            info.setFont(*font);
-            info.setCharacterSize(16);
-            info.setFillColor(sf::Color::White);
-            info.setString("Active: " + std::to_string(slot.itemId) + " x" + std::to_string(slot.count));
+            const std::string info = "Active: " + std::to_string(slot.itemId) + " x" + std::to_string(slot.count);
             const float infoX = xStart;
             const float infoY = y - 22.0f;
-            info.setPosition(infoX, infoY);
-            window.draw(info);
+            textBatch.add(textCache.layout(*font, 16, info), {infoX, infoY}, sf::Color::White);
         }
     }
+    textBatch.draw(target);
 }
 
 void UIRenderSystem::handleInventoryStateChanged(const InventoryStateChangedEvent &ev) {
     hasInventory = true;
+    ++inventoryVersion;
     activeIndex = ev.activeIndex;
     slots.clear();
     slots.reserve(ev.slots.size());
     for (size_t i = 0; i < ev.slots.size(); ++i) {
         const auto &src = ev.slots[i];
-        UISlot dst{};
+        UISnapshot::Slot dst{};
         dst.itemId = src.itemId;
         dst.count = src.count;
+        // Icons are resolved here, once per inventory change, not on every extract().
         if (dst.itemId >= 0) {
             const auto metaIt = ev.itemMeta.find(dst.itemId);
-            if (metaIt != ev.itemMeta.end()) {
-                dst.iconTexture = metaIt->second.texture;
-                dst.iconRegion = metaIt->second.region;
+            if (metaIt != ev.itemMeta.end() && resourceManager.hasAtlasRegion(metaIt->second.region)) {
+                const auto &region = resourceManager.getAtlasRegion(metaIt->second.region);
+                dst.iconTexture = resourceManager.texture(region.texture);
+                dst.iconRect = region.rect;
             }
         }
-        slots.push_back(std::move(dst));
+        slots.push_back(dst);
     }
     if (activeIndex < 0 || activeIndex >= static_cast<int>(slots.size()))
         activeIndex = 0;
@@ -7,6 +7,11 @@
 #include "managers/ResourceManager.h"
 #include "managers/WindowManager.h"
 #include "events/InventoryEvents.h"
+#include "render/Minimap.h"
+#include "render/RenderSnapshot.h"
+#include "render/TextCache.h"
+#include "render/UILayer.h"
+#include <cstdint>
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <unordered_map>
@@ -14,46 +19,28 @@
 
 class UIRenderSystem : public System {
   public:
-    struct MenuRenderButton {
-        std::string id;
-        std::string label;
-        sf::FloatRect rect;
-        bool focused{false};
-    };
-
-    enum class MenuScreen { Main, MapSelect, Pause, Settings };
-
-    struct MenuRenderState {
-        bool visible{false};
-        MenuScreen screen{MenuScreen::Main};
-        std::vector<MenuRenderButton> buttons;
-        std::vector<std::string> maps;
-        int selectedMap{-1};
-        bool hasSave{false};
-        bool canResume{false};
-        bool showMenuButton{false};
-        sf::FloatRect menuButtonRect;
-        bool showDebugButton{false};
-        sf::FloatRect debugButtonRect;
-        std::vector<std::string> settingsLines;
-    };
+    using MenuRenderButton = ::MenuRenderButton;
+    using MenuScreen = ::MenuScreen;
+    using MenuRenderState = ::MenuRenderState;
 
     UIRenderSystem(WindowManager &windowMgr, ResourceManager &resourceMgr, DebugManager &debugMgr, EventBus &eventBus);
+    // Extracts and draws in one go, then presents the window.
     void update(float dt) override;
     void setMenuState(const MenuRenderState *state) { menuState = state; }
+    // Drawn in the top-right corner while playing; nullptr hides it. Read by render() only.
+    void setMinimap(const Minimap *map) { minimap = map; }
 
-  private:
-    struct UISlot {
-        int itemId{-1};
-        int count{0};
-        std::string iconTexture;
-        std::string iconRegion;
-    };
+    // Simulation thread: copies menu and debug state, and the inventory slots when they changed.
+    void extract(UISnapshot &snapshot, float dt);
+    // Render thread: draws the overlay in window pixels on top of the world; does not display().
+    void render(const UISnapshot &snapshot, sf::RenderTarget &target);
 
-    void drawDebugOverlay(float dt);
-    void drawInventoryUI();
-    void drawMenuUI();
-    void drawMenuButton();
+  private:
+    void drawDebugOverlay(const UISnapshot &snapshot, sf::RenderTarget &target);
+    void drawInventoryUI(const UISnapshot &snapshot, sf::RenderTarget &target);
+    void drawMenuUI(const UISnapshot &snapshot, sf::RenderTarget &target);
+    void drawMenuButton(const UISnapshot &snapshot, sf::RenderTarget &target);
+    void drawMinimap(const UISnapshot &snapshot, sf::RenderTarget &target);
     void drawDebugButton();
     void handleInventoryStateChanged(const InventoryStateChangedEvent &ev);
 
@@ -66,11 +53,22 @@ class UIRenderSystem : public System {
     sf::Color debugTextColor{sf::Color::White};
     unsigned int debugCharacterSize{14};
 
-    std::vector<UISlot> slots;
+    std::vector<UISnapshot::Slot> slots; // icons already resolved to textures
     int activeIndex{0};
     bool hasInventory{false};
+    std::uint64_t inventoryVersion{0};
 
     const MenuRenderState *menuState{nullptr};
+    MenuRenderState lastMenu; // last extracted copy, to detect changes
+    std::uint64_t menuVersion{0};
+    UISnapshot syncSnapshot; // used by update()
+
+    // Render side: hotbar + menu button, and the menu overlay, cached until their version changes.
+    const Minimap *minimap{nullptr};
+    UILayer hudLayer;
+    UILayer menuLayer;
+    TextCache textCache;
+    TextBatch textBatch;
 };
 
 #endif // DDD_SYSTEMS_UI_RENDER_SYSTEM_H
@@ -0,0 +1,58 @@
+#include "systems/WorldStreamingSystem.h"
+
+#include "components/Tags.h"
+#include "components/TransformComponent.h"
+#include "events/TileEvents.h"
+#include "utils/Constants.h"
+#include <algorithm>
+#include <cmath>
+
+WorldStreamingSystem::WorldStreamingSystem(WorldStreamer &streamer, CameraManager &cameraMgr,
+                                           EntityManager &entityMgr, EventBus &eventBus)
+    : worldStreamer(streamer), cameraManager(cameraMgr), entityManager(entityMgr), eventBus(eventBus) {}
+
+void WorldStreamingSystem::update(float dt) {
+    (void)dt;
+
+    TilemapComponent *tilemap = nullptr;
+    Vec2 mapOffset{};
+    const TransformComponent *playerTransform = nullptr;
+    for (auto &entPtr : entityManager.all()) {
+        if (!tilemap) {
+            tilemap = entPtr->get<TilemapComponent>();
+            if (const auto *transform = tilemap ? entPtr->get<TransformComponent>() : nullptr)
+                mapOffset = transform->position;
+        }
+        if (!playerTransform && entPtr->has<PlayerTag>())
+            playerTransform = entPtr->get<TransformComponent>();
+        if (tilemap && playerTransform)
+            break;
+    }
+    if (!tilemap || tilemap->tileSize <= 0.0f)
+        return;
+
+    const float chunkWorld = tilemap->tileSize * TileChunkStore::kChunkSize;
+    const Vec2 topLeft = tilemap->origin + mapOffset;
+    const auto chunkAt = [&](const Vec2 &pos) {
+        return WorldStreamer::ChunkCoord{static_cast<int>(std::floor((pos.x - topLeft.x) / chunkWorld)),
+                                         static_cast<int>(std::floor((topLeft.y - pos.y) / chunkWorld))};
+    };
+    focus.clear();
+    focus.push_back(chunkAt(cameraManager.getCenter()));
+    if (playerTransform)
+        focus.push_back(chunkAt(playerTransform->position));
+
+    // The whole view around the camera stays loaded, however far it is zoomed out.
+    const Vec2 viewport = cameraManager.getViewportSize();
+    const float halfViewWorld =
+        std::max(viewport.x, viewport.y) * cameraManager.getZoom() * 0.5f / RENDER_SCALE;
+    const int viewRadius = static_cast<int>(std::ceil(halfViewWorld / chunkWorld));
+
+    loaded.clear();
+    unloaded.clear();
+    worldStreamer.update(tilemap->tiles, focus, viewRadius, loaded, unloaded);
+    for (const auto &c : loaded)
+        eventBus.emit(ChunkLoadedEvent{c.x, c.y});
+    for (const auto &c : unloaded)
+        eventBus.emit(ChunkUnloadedEvent{c.x, c.y});
+}
@@ -0,0 +1,31 @@
+#ifndef DDD_SYSTEMS_WORLD_STREAMING_SYSTEM_H
+#define DDD_SYSTEMS_WORLD_STREAMING_SYSTEM_H
+
+#include "components/TilemapComponent.h"
+#include "core/EntityManager.h"
+#include "core/EventBus.h"
+#include "core/System.h"
+#include "managers/CameraManager.h"
+#include "managers/WorldStreamer.h"
+#include <vector>
+
+// Keeps the tilemap's chunks resident around the camera and the player: the streamer loads the visible area
+// (plus its radius) in the background and evicts what fell behind. Chunk events go out on the bus.
+class WorldStreamingSystem : public System {
+  public:
+    WorldStreamingSystem(WorldStreamer &streamer, CameraManager &cameraMgr, EntityManager &entityMgr,
+                         EventBus &eventBus);
+    void update(float dt) override;
+
+  private:
+    WorldStreamer &worldStreamer;
+    CameraManager &cameraManager;
+    EntityManager &entityManager;
+    EventBus &eventBus;
+
+    std::vector<WorldStreamer::ChunkCoord> focus; // reused between frames
+    std::vector<WorldStreamer::ChunkCoord> loaded;
+    std::vector<WorldStreamer::ChunkCoord> unloaded;
+};
+
+#endif // DDD_SYSTEMS_WORLD_STREAMING_SYSTEM_H
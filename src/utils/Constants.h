@@ -11,8 +11,12 @@ constexpr float RENDER_SCALE = 32.0f;   // 1 world unit == 32 pixels
 
 // Physics step
 constexpr float PHYSICS_TIMESTEP = 1.0f / 60.0f;
-constexpr int PHYSICS_VELOCITY_ITER = 8;
+constexpr int PHYSICS_VELOCITY_ITER = 8; // solver iterations at full quality
 constexpr int PHYSICS_POSITION_ITER = 3;
+constexpr int PHYSICS_MIN_VELOCITY_ITER = 2; // floor when degrading under load
+constexpr int PHYSICS_MIN_POSITION_ITER = 1;
+constexpr int PHYSICS_MAX_STEPS_PER_FRAME = 5;
+constexpr float PHYSICS_STEP_BUDGET_MS = 8.0f;
 
 #endif // DDD_UTILS_CONSTANTS_H
 
@@ -0,0 +1,160 @@
+#ifndef DDD_UTILS_PARTICLE_POOL_H
+#define DDD_UTILS_PARTICLE_POOL_H
+
+#include "utils/TileChunkStore.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Solid/empty lookup over a tile grid, for particle collision (world units, y up, origin = top-left corner).
+struct ParticleTileGrid {
+    // Last chunk looked up; debris stays clustered, so most lookups skip the hash map. One per integrating slice.
+    struct Cursor {
+        TileChunkStore::Key key{~TileChunkStore::Key{0}};
+        const TileChunk *chunk{nullptr};
+    };
+
+    const TileChunkStore *tiles{nullptr}; // y grows downward; chunks that are not resident count as empty
+    int width{0};
+    int height{0};
+    float originX{0.0f};
+    float originY{0.0f};
+    float invTileSize{1.0f};
+
+    bool solidAt(float x, float y, Cursor &cursor) const {
+        const int tx = static_cast<int>(std::floor((x - originX) * invTileSize));
+        const int ty = static_cast<int>(std::floor((originY - y) * invTileSize));
+        if (tx < 0 || ty < 0 || tx >= width || ty >= height)
+            return false;
+        const TileChunkStore::Key key = TileChunkStore::keyForTile(tx, ty);
+        if (key != cursor.key) {
+            cursor.key = key;
+            cursor.chunk = tiles->find(key);
+        }
+        return cursor.chunk && cursor.chunk->solid(TileChunkStore::localIndex(tx, ty));
+    }
+};
+
+// Fixed-capacity particle storage in structure-of-arrays form. Live particles are packed in [0, size()),
+// so integrate() runs over plain float arrays the compiler can vectorize. Slices touch disjoint elements,
+// so [begin, end) ranges can be integrated on different threads; compact() must then run alone.
+class ParticlePool {
+  public:
+    struct Settings {
+        std::size_t capacity{4096};
+        float gravity{0.0f};     // world units / s^2 along y (world y up)
+        float drag{0.0f};        // fraction of velocity lost per second
+        bool collide{false};     // against ParticleTileGrid
+        float restitution{0.3f}; // velocity kept (and reflected) on impact
+    };
+
+    explicit ParticlePool(const Settings &s) : settings(s) {
+        for (auto *v : {&posX, &posY, &velX, &velY, &life, &invMaxLife, &size})
+            v->resize(settings.capacity);
+        color.resize(settings.capacity);
+    }
+
+    // Returns false (and drops the particle) when the pool is full.
+    bool spawn(float x, float y, float vx, float vy, float lifetime, float particleSize, std::uint32_t rgba) {
+        if (count == settings.capacity || lifetime <= 0.0f)
+            return false;
+        const std::size_t i = count++;
+        posX[i] = x;
+        posY[i] = y;
+        velX[i] = vx;
+        velY[i] = vy;
+        life[i] = lifetime;
+        invMaxLife[i] = 1.0f / lifetime;
+        size[i] = particleSize;
+        color[i] = rgba;
+        return true;
+    }
+
+    void integrate(float dt, const ParticleTileGrid *grid, std::size_t begin, std::size_t end) {
+        end = std::min(end, count);
+        if (begin >= end)
+            return;
+        const float gdt = settings.gravity * dt;
+        const float damp = std::max(0.0f, 1.0f - settings.drag * dt);
+        float *const px = posX.data();
+        float *const py = posY.data();
+        float *const vx = velX.data();
+        float *const vy = velY.data();
+        float *const lf = life.data();
+        for (std::size_t i = begin; i < end; ++i) {
+            vy[i] = (vy[i] + gdt) * damp;
+            vx[i] = vx[i] * damp;
+            px[i] += vx[i] * dt;
+            py[i] += vy[i] * dt;
+            lf[i] -= dt;
+        }
+
+        if (!settings.collide || !grid || !grid->tiles)
+            return;
+        // Scalar pass: undo the step along the axis that entered a solid tile and bounce off it.
+        const float bounce = -settings.restitution;
+        ParticleTileGrid::Cursor cursor;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!grid->solidAt(px[i], py[i], cursor))
+                continue;
+            const float prevX = px[i] - vx[i] * dt;
+            const float prevY = py[i] - vy[i] * dt;
+            if (!grid->solidAt(px[i], prevY, cursor)) {
+                py[i] = prevY;
+                vy[i] *= bounce;
+                vx[i] *= settings.restitution;
+            } else if (!grid->solidAt(prevX, py[i], cursor)) {
+                px[i] = prevX;
+                vx[i] *= bounce;
+            } else {
+                px[i] = prevX;
+                py[i] = prevY;
+                vx[i] = 0.0f;
+                vy[i] = 0.0f;
+            }
+        }
+    }
+
+    void integrate(float dt, const ParticleTileGrid *grid) { integrate(dt, grid, 0, count); }
+
+    // Swap-removes expired particles; order is not preserved.
+    void compact() {
+        std::size_t i = 0;
+        while (i < count) {
+            if (life[i] > 0.0f) {
+                ++i;
+                continue;
+            }
+            const std::size_t last = --count;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            life[i] = life[last];
+            invMaxLife[i] = invMaxLife[last];
+            size[i] = size[last];
+            color[i] = color[last];
+        }
+    }
+
+    void clear() { count = 0; }
+
+    std::size_t getCount() const { return count; }
+    std::size_t getCapacity() const { return settings.capacity; }
+    const float *x() const { return posX.data(); }
+    const float *y() const { return posY.data(); }
+    const float *sizes() const { return size.data(); }
+    const std::uint32_t *colors() const { return color.data(); }
+    // Remaining life in [0, 1].
+    float lifeFraction(std::size_t i) const { return std::clamp(life[i] * invMaxLife[i], 0.0f, 1.0f); }
+
+  private:
+    Settings settings;
+    std::size_t count{0};
+    std::vector<float> posX, posY, velX, velY, life, invMaxLife, size;
+    std::vector<std::uint32_t> color; // 0xRRGGBBAA
+};
+
+#endif // DDD_UTILS_PARTICLE_POOL_H
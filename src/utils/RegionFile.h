@@ -0,0 +1,138 @@
+#ifndef DDD_UTILS_REGION_FILE_H
+#define DDD_UTILS_REGION_FILE_H
+
+#include "utils/TileChunkStore.h"
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Chunk persistence: kRegionSize x kRegionSize chunks share one file "r.<rx>.<ry>.bin" under a directory.
+// Layout: magic, version, then an offset table (offset, byte size) per chunk slot, then chunk payloads.
+// A rewritten chunk reuses its slot when it fits and is appended otherwise. Payloads are TileChunk::encode()
+// output (palette-compressed, native byte order); these files are a local cache, never shipped.
+class RegionFile {
+  public:
+    static constexpr int kRegionShift = 5;
+    static constexpr int kRegionSize = 1 << kRegionShift;
+    static constexpr int kSlots = kRegionSize * kRegionSize;
+    static constexpr std::uint32_t kVersion = 2;
+
+    static std::filesystem::path pathFor(const std::filesystem::path &dir, int cx, int cy) {
+        return dir / ("r." + std::to_string(cx >> kRegionShift) + "." + std::to_string(cy >> kRegionShift) + ".bin");
+    }
+
+    // Returns false when the region or the chunk slot does not exist or does not decode.
+    static bool read(const std::filesystem::path &dir, int cx, int cy, TileChunk &chunk) {
+        std::ifstream in(pathFor(dir, cx, cy), std::ios::binary);
+        Table table;
+        if (!in.is_open() || !readTable(in, table))
+            return false;
+        const Slot &slot = table[slotIndex(cx, cy)];
+        if (slot.size == 0)
+            return false;
+        std::vector<std::uint8_t> payload(slot.size);
+        in.seekg(slot.offset);
+        in.read(reinterpret_cast<char *>(payload.data()), slot.size);
+        return in && chunk.decode(payload.data(), payload.size());
+    }
+
+    static bool write(const std::filesystem::path &dir, int cx, int cy, const TileChunk &chunk) {
+        std::vector<std::uint8_t> payload;
+        chunk.encode(payload);
+        const auto bytes = static_cast<std::uint32_t>(payload.size());
+        const std::filesystem::path path = pathFor(dir, cx, cy);
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+
+        Table table{};
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (in.is_open() && !readTable(in, table))
+                table = Table{};
+        }
+        std::fstream io(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!io.is_open()) {
+            // New region: header and an empty table first.
+            std::ofstream create(path, std::ios::binary | std::ios::trunc);
+            if (!create.is_open())
+                return false;
+            create.close();
+            io.open(path, std::ios::binary | std::ios::in | std::ios::out);
+            if (!io.is_open() || !writeTable(io, table))
+                return false;
+        }
+
+        Slot &slot = table[slotIndex(cx, cy)];
+        if (slot.size < bytes) {
+            io.seekp(0, std::ios::end);
+            slot.offset = static_cast<std::uint32_t>(io.tellp());
+        }
+        slot.size = bytes;
+        io.seekp(slot.offset);
+        io.write(reinterpret_cast<const char *>(payload.data()), bytes);
+        return writeTable(io, table);
+    }
+
+    // Writes a whole region at once, replacing the file; slots[i] (region-local chunk index) may be null.
+    static bool writeRegion(const std::filesystem::path &dir, int rx, int ry,
+                            const std::array<const TileChunk *, kSlots> &slots) {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        std::ofstream out(pathFor(dir, rx << kRegionShift, ry << kRegionShift), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        Table table{};
+        std::vector<std::uint8_t> payloads;
+        std::vector<std::uint8_t> payload;
+        const std::uint32_t dataStart = sizeof(std::uint32_t) * 2 + sizeof(Table);
+        for (int i = 0; i < kSlots; ++i) {
+            if (!slots[i])
+                continue;
+            slots[i]->encode(payload);
+            table[i] = Slot{dataStart + static_cast<std::uint32_t>(payloads.size()),
+                            static_cast<std::uint32_t>(payload.size())};
+            payloads.insert(payloads.end(), payload.begin(), payload.end());
+        }
+        if (!writeTable(out, table))
+            return false;
+        out.write(reinterpret_cast<const char *>(payloads.data()), static_cast<std::streamsize>(payloads.size()));
+        return static_cast<bool>(out);
+    }
+
+    static int slotIndex(int cx, int cy) {
+        return ((cy & (kRegionSize - 1)) << kRegionShift) | (cx & (kRegionSize - 1));
+    }
+
+  private:
+    static constexpr std::uint32_t kMagic = 0x52444444u; // "DDDR"
+
+    struct Slot {
+        std::uint32_t offset{0};
+        std::uint32_t size{0};
+    };
+    using Table = std::array<Slot, kSlots>;
+
+    static bool readTable(std::istream &in, Table &table) {
+        std::uint32_t header[2]{};
+        in.read(reinterpret_cast<char *>(header), sizeof(header));
+        if (!in || header[0] != kMagic || header[1] != kVersion)
+            return false;
+        in.read(reinterpret_cast<char *>(table.data()), sizeof(Table));
+        return static_cast<bool>(in);
+    }
+
+    static bool writeTable(std::ostream &out, const Table &table) {
+        const std::uint32_t header[2]{kMagic, kVersion};
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(table.data()), sizeof(Table));
+        out.flush();
+        return static_cast<bool>(out);
+    }
+};
+
+#endif // DDD_UTILS_REGION_FILE_H
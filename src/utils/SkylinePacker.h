@@ -0,0 +1,111 @@
+#ifndef DDD_UTILS_SKYLINE_PACKER_H
+#define DDD_UTILS_SKYLINE_PACKER_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Skyline bottom-left rectangle packer for a fixed-size page.
+// The skyline is a list of horizontal segments; each insert picks the spot with the lowest resulting top edge.
+class SkylinePacker {
+  public:
+    struct Rect {
+        int x{0};
+        int y{0};
+        int w{0};
+        int h{0};
+    };
+
+    SkylinePacker(int pageWidth, int pageHeight) : width(pageWidth), height(pageHeight) {
+        skyline.push_back(Segment{0, 0, width});
+    }
+
+    std::optional<Rect> insert(int w, int h) {
+        if (w <= 0 || h <= 0 || w > width || h > height)
+            return std::nullopt;
+
+        std::size_t bestIndex = skyline.size();
+        int bestTop = INT_MAX;
+        int bestSegmentWidth = INT_MAX;
+        Rect best;
+        for (std::size_t i = 0; i < skyline.size(); ++i) {
+            const int y = fit(i, w, h);
+            if (y < 0)
+                continue;
+            const int top = y + h;
+            if (top < bestTop || (top == bestTop && skyline[i].w < bestSegmentWidth)) {
+                bestIndex = i;
+                bestTop = top;
+                bestSegmentWidth = skyline[i].w;
+                best = Rect{skyline[i].x, y, w, h};
+            }
+        }
+        if (bestIndex == skyline.size())
+            return std::nullopt;
+
+        addLevel(bestIndex, best);
+        usedHeight = std::max(usedHeight, best.y + best.h);
+        return best;
+    }
+
+    // Lowest page height that still contains everything inserted so far.
+    int getUsedHeight() const { return usedHeight; }
+
+  private:
+    struct Segment {
+        int x{0};
+        int y{0};
+        int w{0};
+    };
+
+    // Y at which a w x h rect starting at segment `index` rests, or -1 if it does not fit.
+    int fit(std::size_t index, int w, int h) const {
+        if (skyline[index].x + w > width)
+            return -1;
+        int y = skyline[index].y;
+        int remaining = w;
+        for (std::size_t i = index; remaining > 0; ++i) {
+            y = std::max(y, skyline[i].y);
+            if (y + h > height)
+                return -1;
+            remaining -= skyline[i].w;
+        }
+        return y;
+    }
+
+    void addLevel(std::size_t index, const Rect &rect) {
+        skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(index), Segment{rect.x, rect.y + rect.h, rect.w});
+
+        // Trim segments now covered by the new one.
+        for (std::size_t i = index + 1; i < skyline.size();) {
+            const Segment &prev = skyline[i - 1];
+            const int overlap = prev.x + prev.w - skyline[i].x;
+            if (overlap <= 0)
+                break;
+            skyline[i].x += overlap;
+            skyline[i].w -= overlap;
+            if (skyline[i].w > 0)
+                break;
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        // Merge neighbours at the same height.
+        for (std::size_t i = 0; i + 1 < skyline.size();) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].w += skyline[i + 1].w;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    int width{0};
+    int height{0};
+    int usedHeight{0};
+    std::vector<Segment> skyline;
+};
+
+#endif // DDD_UTILS_SKYLINE_PACKER_H
@@ -0,0 +1,415 @@
+#ifndef DDD_UTILS_TILE_CHUNK_STORE_H
+#define DDD_UTILS_TILE_CHUNK_STORE_H
+
+#include "utils/TileJournal.h"
+#include "utils/TileRegistry.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Tile ids of one square chunk (row-major, y grows downward like the tilemap), palette-compressed: each tile holds
+// an index into `palette` using 0, 1, 2, 4 or 8 bits (0 = the whole chunk is one id); chunks with more than 256
+// distinct ids fall back to plain 16-bit ids. Ids are stored as uint16 with -1 mapped to 0xFFFF.
+// A parallel bitset keeps one 32-bit word of solidity per row, maintained on every write by TileChunkStore.
+class TileChunk {
+  public:
+    static constexpr int kShift = 5;
+    static constexpr int kSize = 1 << kShift;
+    static constexpr int kArea = kSize * kSize;
+    static constexpr int kDirectBits = 16;
+    static_assert(kSize == 32, "solidity rows are one 32-bit word");
+
+    using TileId = std::uint16_t;
+
+    TileChunk() : TileChunk(-1) {}
+    explicit TileChunk(int fill) { reset(fill); }
+
+    bool dirty{false}; // edited since it was read from disk
+
+    void reset(int fill) {
+        palette.assign(1, toStored(fill));
+        bits = 0;
+        bitsLog2 = 0;
+        packed.clear();
+        direct.clear();
+        solidRows.fill(0);
+    }
+
+    int get(int i) const { return fromStored(stored(i)); }
+
+    // Returns true when the tile changed.
+    bool set(int i, int id) {
+        const TileId value = toStored(id);
+        if (bits == kDirectBits) {
+            if (direct[i] == value)
+                return false;
+            direct[i] = value;
+            return true;
+        }
+        int slot = paletteSlot(value);
+        if (slot < 0) {
+            if (palette.size() == (std::size_t{1} << bits))
+                widen();
+            if (bits == kDirectBits) {
+                direct[i] = value;
+                return true;
+            }
+            palette.push_back(value);
+            slot = static_cast<int>(palette.size()) - 1;
+        }
+        if (bits == 0 || index(i) == static_cast<unsigned>(slot))
+            return false;
+        writeIndex(i, static_cast<unsigned>(slot));
+        return true;
+    }
+
+    // Replaces every tile from kArea ids, with the smallest palette that fits.
+    void assign(const int *ids) {
+        palette.clear();
+        std::array<std::uint8_t, kArea> slots;
+        for (int i = 0; i < kArea; ++i) {
+            const TileId value = toStored(ids[i]);
+            int slot = paletteSlot(value);
+            if (slot < 0) {
+                if (palette.size() == 256) {
+                    toDirect(ids);
+                    return;
+                }
+                palette.push_back(value);
+                slot = static_cast<int>(palette.size()) - 1;
+            }
+            slots[i] = static_cast<std::uint8_t>(slot);
+        }
+        direct.clear();
+        setBits(bitsFor(palette.size()));
+        packed.assign(bits == 0 ? 0 : (kArea << bitsLog2) / 64, 0);
+        if (bits != 0) {
+            for (int i = 0; i < kArea; ++i)
+                writeIndex(i, slots[i]);
+        }
+    }
+
+    void copyTo(int *ids) const {
+        for (int i = 0; i < kArea; ++i)
+            ids[i] = get(i);
+    }
+
+    bool uniform(int id) const {
+        const TileId value = toStored(id);
+        if (bits == 0)
+            return palette[0] == value;
+        for (int i = 0; i < kArea; ++i) {
+            if (stored(i) != value)
+                return false;
+        }
+        return true;
+    }
+
+    int bitsPerTile() const { return bits; }
+    std::size_t byteSize() const {
+        return sizeof(TileChunk) + palette.capacity() * sizeof(TileId) + packed.capacity() * sizeof(std::uint64_t) +
+               direct.capacity() * sizeof(TileId);
+    }
+
+    std::uint32_t solidRow(int ly) const { return solidRows[ly]; }
+    bool solid(int i) const { return (solidRows[i >> kShift] >> (i & (kSize - 1))) & 1u; }
+    void setSolid(int i, bool isSolid) {
+        const std::uint32_t bit = 1u << (i & (kSize - 1));
+        solidRows[i >> kShift] = isSolid ? (solidRows[i >> kShift] | bit) : (solidRows[i >> kShift] & ~bit);
+    }
+    // isSolidId(int id) -> bool; a homogeneous chunk is one call.
+    template <typename Fn> void refreshSolid(Fn &&isSolidId) {
+        if (bits == 0) {
+            solidRows.fill(isSolidId(fromStored(palette[0])) ? ~0u : 0u);
+            return;
+        }
+        solidRows.fill(0);
+        for (int i = 0; i < kArea; ++i) {
+            if (isSolidId(get(i)))
+                solidRows[i >> kShift] |= 1u << (i & (kSize - 1));
+        }
+    }
+
+    // Serialized form: bits, palette size, palette ids, then packed words (or 16-bit ids); native byte order.
+    void encode(std::vector<std::uint8_t> &out) const {
+        const std::uint16_t header[2]{static_cast<std::uint16_t>(bits), static_cast<std::uint16_t>(palette.size())};
+        out.clear();
+        append(out, header, sizeof(header));
+        append(out, palette.data(), palette.size() * sizeof(TileId));
+        append(out, packed.data(), packed.size() * sizeof(std::uint64_t));
+        append(out, direct.data(), direct.size() * sizeof(TileId));
+    }
+
+    bool decode(const std::uint8_t *data, std::size_t size) {
+        std::uint16_t header[2]{};
+        if (size < sizeof(header))
+            return false;
+        std::memcpy(header, data, sizeof(header));
+        const int encodedBits = header[0];
+        const std::size_t paletteSize = header[1];
+        if (encodedBits == kDirectBits) {
+            if (paletteSize != 0 || size != sizeof(header) + kArea * sizeof(TileId))
+                return false;
+            palette.clear();
+            packed.clear();
+            direct.resize(kArea);
+            std::memcpy(direct.data(), data + sizeof(header), kArea * sizeof(TileId));
+            setBits(kDirectBits);
+            return true;
+        }
+        if (encodedBits > 8 || std::popcount(static_cast<unsigned>(encodedBits)) > 1 || paletteSize == 0 ||
+            paletteSize > (std::size_t{1} << encodedBits))
+            return false;
+        const std::size_t words = encodedBits == 0 ? 0 : (static_cast<std::size_t>(kArea) * encodedBits) / 64;
+        if (size != sizeof(header) + paletteSize * sizeof(TileId) + words * sizeof(std::uint64_t))
+            return false;
+        palette.resize(paletteSize);
+        std::memcpy(palette.data(), data + sizeof(header), paletteSize * sizeof(TileId));
+        packed.resize(words);
+        const std::uint8_t *indices = data + sizeof(header) + paletteSize * sizeof(TileId);
+        if (words != 0)
+            std::memcpy(packed.data(), indices, words * sizeof(std::uint64_t));
+        direct.clear();
+        setBits(encodedBits);
+        return true;
+    }
+
+  private:
+    static TileId toStored(int id) { return static_cast<TileId>(id); }
+    static int fromStored(TileId v) { return v == 0xFFFF ? -1 : static_cast<int>(v); }
+    static int bitsFor(std::size_t paletteSize) {
+        int b = 0;
+        while ((std::size_t{1} << b) < paletteSize)
+            b = b == 0 ? 1 : b * 2;
+        return b;
+    }
+
+    template <typename T> static void append(std::vector<std::uint8_t> &out, const T *src, std::size_t bytes) {
+        const auto *p = reinterpret_cast<const std::uint8_t *>(src);
+        out.insert(out.end(), p, p + bytes);
+    }
+
+    void setBits(int b) {
+        bits = b;
+        bitsLog2 = b == 0 || b == kDirectBits ? 0 : std::countr_zero(static_cast<unsigned>(b));
+    }
+
+    int paletteSlot(TileId value) const {
+        for (std::size_t s = 0; s < palette.size(); ++s) {
+            if (palette[s] == value)
+                return static_cast<int>(s);
+        }
+        return -1;
+    }
+
+    unsigned index(int i) const {
+        const unsigned bitPos = static_cast<unsigned>(i) << bitsLog2;
+        return static_cast<unsigned>(packed[bitPos >> 6] >> (bitPos & 63)) & ((1u << bits) - 1u);
+    }
+
+    void writeIndex(int i, unsigned slot) {
+        const unsigned bitPos = static_cast<unsigned>(i) << bitsLog2;
+        const std::uint64_t mask = ((std::uint64_t{1} << bits) - 1) << (bitPos & 63);
+        std::uint64_t &word = packed[bitPos >> 6];
+        word = (word & ~mask) | (static_cast<std::uint64_t>(slot) << (bitPos & 63));
+    }
+
+    TileId stored(int i) const {
+        if (bits == kDirectBits)
+            return direct[i];
+        return bits == 0 ? palette[0] : palette[index(i)];
+    }
+
+    // Palette is full: double the index width, or switch to 16-bit ids past 8 bits.
+    void widen() {
+        std::array<int, kArea> ids;
+        copyTo(ids.data());
+        if (bits == 8) {
+            toDirect(ids.data());
+            return;
+        }
+        const std::vector<TileId> keep = palette;
+        const int next = bits == 0 ? 1 : bits * 2;
+        setBits(next);
+        packed.assign((kArea << bitsLog2) / 64, 0);
+        for (int i = 0; i < kArea; ++i) {
+            const auto it = std::find(keep.begin(), keep.end(), toStored(ids[i]));
+            writeIndex(i, static_cast<unsigned>(it - keep.begin()));
+        }
+    }
+
+    void toDirect(const int *ids) {
+        direct.resize(kArea);
+        for (int i = 0; i < kArea; ++i)
+            direct[i] = toStored(ids[i]);
+        palette.clear();
+        packed.clear();
+        setBits(kDirectBits);
+    }
+
+    std::vector<TileId> palette;
+    std::vector<std::uint64_t> packed; // palette indices, `bits` each
+    std::vector<TileId> direct;        // kDirectBits only
+    int bits{0};
+    int bitsLog2{0};
+    std::array<std::uint32_t, kSize> solidRows{};
+};
+
+// Sparse tile storage: chunks live in a hash map keyed by chunk coordinate and only resident chunks take memory.
+// Tile (x, y) sits in chunk (x >> kChunkShift, y >> kChunkShift). Reads outside resident chunks return
+// kNotResident and writes there are refused, so callers never mistake streamed-out terrain for air they can edit.
+// Solidity is taken once from the TileRegistry (setSolidity); every chunk keeps its solidity rows in sync
+// with its tiles.
+class TileChunkStore {
+  public:
+    using Key = std::uint64_t;
+
+    static constexpr int kChunkShift = TileChunk::kShift;
+    static constexpr int kChunkSize = TileChunk::kSize;
+    static constexpr int kChunkArea = TileChunk::kArea;
+    static constexpr int kNotResident = -1;
+
+    static int chunkCoord(int tile) { return tile >> kChunkShift; } // floors negative coordinates too
+    static int localIndex(int x, int y) { return ((y & (kChunkSize - 1)) << kChunkShift) | (x & (kChunkSize - 1)); }
+    static Key key(int cx, int cy) {
+        return (static_cast<Key>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+    }
+    static Key keyForTile(int x, int y) { return key(chunkCoord(x), chunkCoord(y)); }
+    static int keyX(Key k) { return static_cast<int>(static_cast<std::uint32_t>(k >> 32)); }
+    static int keyY(Key k) { return static_cast<int>(static_cast<std::uint32_t>(k)); }
+
+    void setSolidity(const TileRegistry &registry) {
+        solidById.assign(registry.size(), 0);
+        for (int id = 0; id < registry.size(); ++id)
+            solidById[id] = registry.solid(id) ? 1 : 0;
+        for (auto &[k, chunk] : chunks)
+            refreshSolid(chunk);
+    }
+
+    bool isSolidId(int id) const {
+        return id >= 0 && id < static_cast<int>(solidById.size()) && solidById[id] != 0;
+    }
+
+    int get(int x, int y) const {
+        const TileChunk *chunk = find(keyForTile(x, y));
+        return chunk ? chunk->get(localIndex(x, y)) : kNotResident;
+    }
+
+    bool solidAt(int x, int y) const {
+        const TileChunk *chunk = find(keyForTile(x, y));
+        return chunk && chunk->solid(localIndex(x, y));
+    }
+
+    // Any solid tile in row y, columns [x0, x1]; tested a chunk row (32 tiles) at a time.
+    bool anySolidInRow(int y, int x0, int x1) const {
+        const int ly = y & (kChunkSize - 1);
+        for (int cx = chunkCoord(x0); cx <= chunkCoord(x1); ++cx) {
+            const TileChunk *chunk = find(key(cx, chunkCoord(y)));
+            if (!chunk)
+                continue;
+            const int lo = std::max(x0 - cx * kChunkSize, 0);
+            const int hi = std::min(x1 - cx * kChunkSize, kChunkSize - 1);
+            const std::uint32_t span = (hi == kChunkSize - 1 ? ~0u : ((1u << (hi + 1)) - 1u)) & (~0u << lo);
+            if (chunk->solidRow(ly) & span)
+                return true;
+        }
+        return false;
+    }
+
+    // Returns false when the chunk is not resident. Changes mark the chunk dirty and are journaled.
+    bool set(int x, int y, int tileId) {
+        TileChunk *chunk = find(keyForTile(x, y));
+        if (!chunk)
+            return false;
+        const int i = localIndex(x, y);
+        const int before = chunk->get(i);
+        if (chunk->set(i, tileId)) {
+            chunk->setSolid(i, isSolidId(tileId));
+            chunk->dirty = true;
+            edits.record(x, y, before, tileId);
+            frameEdits.record(x, y, before, tileId);
+        }
+        return true;
+    }
+
+    TileChunk *find(Key k) {
+        auto it = chunks.find(k);
+        return it != chunks.end() ? &it->second : nullptr;
+    }
+    const TileChunk *find(Key k) const {
+        auto it = chunks.find(k);
+        return it != chunks.end() ? &it->second : nullptr;
+    }
+    TileChunk *find(int cx, int cy) { return find(key(cx, cy)); }
+    const TileChunk *find(int cx, int cy) const { return find(key(cx, cy)); }
+
+    // Makes a chunk resident (replacing any previous copy) and derives its solidity rows.
+    TileChunk &insert(int cx, int cy, TileChunk chunk) {
+        TileChunk &slot = chunks[key(cx, cy)];
+        slot = std::move(chunk);
+        refreshSolid(slot);
+        return slot;
+    }
+
+    // Resident chunk at (cx, cy), created filled with `fill` when missing.
+    TileChunk &ensure(int cx, int cy, int fill) {
+        auto [it, inserted] = chunks.try_emplace(key(cx, cy), fill);
+        if (inserted)
+            refreshSolid(it->second);
+        return it->second;
+    }
+
+    bool erase(int cx, int cy) { return chunks.erase(key(cx, cy)) != 0; }
+
+    // fn(Key, TileChunk &) for every resident chunk; the map must not change during the walk.
+    template <typename Fn> void forEach(Fn &&fn) {
+        for (auto &[k, chunk] : chunks)
+            fn(k, chunk);
+    }
+    template <typename Fn> void forEach(Fn &&fn) const {
+        for (const auto &[k, chunk] : chunks)
+            fn(k, chunk);
+    }
+
+    void clear() {
+        chunks.clear();
+        edits.clear();
+        frameEdits.clear();
+    }
+
+    std::size_t size() const { return chunks.size(); }
+    bool empty() const { return chunks.empty(); }
+    std::size_t byteSize() const {
+        std::size_t total = 0;
+        for (const auto &[k, chunk] : chunks)
+            total += chunk.byteSize();
+        return total;
+    }
+
+    // Cells written through set() since the map was loaded, including ones streamed out since.
+    const TileJournal &journal() const { return edits; }
+
+    // Cells changed since the previous call (coalesced per cell); `out` is cleared and swapped in.
+    void takeFrameEdits(TileJournal &out) {
+        out.clear();
+        std::swap(out, frameEdits);
+    }
+
+  private:
+    void refreshSolid(TileChunk &chunk) const {
+        chunk.refreshSolid([this](int id) { return isSolidId(id); });
+    }
+
+    std::unordered_map<Key, TileChunk> chunks;
+    TileJournal edits;
+    TileJournal frameEdits; // drained once per frame by TileChangeBatchSystem
+    std::vector<std::uint8_t> solidById;
+};
+
+#endif // DDD_UTILS_TILE_CHUNK_STORE_H
@@ -0,0 +1,54 @@
+#ifndef DDD_UTILS_TILE_JOURNAL_H
+#define DDD_UTILS_TILE_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Record of every tile edited since the map was loaded: one entry per cell, holding the id the cell had before
+// its first edit (the base map value) and its latest id. Kept independent of chunk residency, so saves read the
+// journal alone and their cost scales with the number of edited cells, not with the map area.
+class TileJournal {
+  public:
+    struct Entry {
+        int x{0};
+        int y{0};
+        int before{-1}; // id before the first edit
+        int after{-1};  // id after the latest edit
+    };
+
+    void record(int x, int y, int before, int after) {
+        const auto [it, inserted] = index.try_emplace(cellKey(x, y), entries.size());
+        if (inserted)
+            entries.push_back(Entry{x, y, before, after});
+        else
+            entries[it->second].after = after;
+    }
+
+    // fn(const Entry &) for every cell whose id differs from its base value, in first-edit order.
+    template <typename Fn> void forEachChange(Fn &&fn) const {
+        for (const Entry &e : entries) {
+            if (e.before != e.after)
+                fn(e);
+        }
+    }
+
+    const std::vector<Entry> &all() const { return entries; }
+    std::size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    void clear() {
+        entries.clear();
+        index.clear();
+    }
+
+  private:
+    static std::uint64_t cellKey(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    std::vector<Entry> entries;
+    std::unordered_map<std::uint64_t, std::size_t> index; // cellKey -> entries index
+};
+
+#endif // DDD_UTILS_TILE_JOURNAL_H
@@ -0,0 +1,104 @@
+#ifndef DDD_UTILS_TILE_REGISTRY_H
+#define DDD_UTILS_TILE_REGISTRY_H
+
+#include "managers/ResourceHandles.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Behaviour and look of one tile id.
+struct TileProperties {
+    enum Flag : std::uint8_t {
+        Solid = 1u << 0,     // collides (tile bodies, character controller, particles)
+        Opaque = 1u << 1,    // blocks light / sight
+        Liquid = 1u << 2,    // fluid tile
+        Breakable = 1u << 3, // can be mined by the player
+    };
+    static constexpr int kDropSelf = -2; // dropItem value: the broken tile drops its own id
+
+
+    std::uint8_t flags{0};
+    std::uint8_t light{0};           // emitted light level, 0 = none
+    float hardness{1.0f};            // relative mining effort
+    int dropItem{kDropSelf};         // item id spawned when broken, -1 = nothing
+    RegionHandle region{kInvalidHandle}; // resolved atlas region, filled once regions are registered
+
+    constexpr bool has(Flag f) const { return (flags & f) != 0; }
+};
+
+// Dense per-id tile property table, built once when a map is loaded: every per-tile query is one array load.
+// Ids outside the table (never configured) are breakable, non-solid and drop themselves.
+class TileRegistry {
+  public:
+    static constexpr TileProperties kUnknown{TileProperties::Breakable, 0, 1.0f, TileProperties::kDropSelf,
+                                             kInvalidHandle};
+
+    // Read-only window over the table; cheap to copy and usable in constant expressions over constexpr arrays.
+    struct View {
+        const TileProperties *data{nullptr};
+        int count{0};
+
+        constexpr const TileProperties &operator[](int id) const {
+            return id >= 0 && id < count ? data[id] : kUnknown;
+        }
+        constexpr bool solid(int id) const { return (*this)[id].has(TileProperties::Solid); }
+    };
+
+    // Entry for `id`, created with the defaults of an unknown tile (breakable, drops itself) when missing.
+    TileProperties &define(int id) {
+        if (id >= static_cast<int>(props.size())) {
+            props.resize(id + 1, kUnknown);
+            names.resize(id + 1);
+        }
+        return props[id];
+    }
+
+    // Marks `id` as the empty tile: nothing to collide with, mine or drop.
+    void defineEmpty(int id) {
+        if (id < 0)
+            return;
+        TileProperties &p = define(id);
+        p = TileProperties{};
+        p.hardness = 0.0f;
+        p.dropItem = -1;
+    }
+
+    void setRegionName(int id, std::string name) {
+        if (id < 0)
+            return;
+        define(id);
+        names[id] = std::move(name);
+    }
+
+    const TileProperties &operator[](int id) const { return view()[id]; }
+    View view() const { return View{props.data(), static_cast<int>(props.size())}; }
+    std::span<const TileProperties> all() const { return props; }
+    int size() const { return static_cast<int>(props.size()); }
+
+    bool solid(int id) const { return (*this)[id].has(TileProperties::Solid); }
+    bool opaque(int id) const { return (*this)[id].has(TileProperties::Opaque); }
+    bool liquid(int id) const { return (*this)[id].has(TileProperties::Liquid); }
+    bool breakable(int id) const { return (*this)[id].has(TileProperties::Breakable); }
+    RegionHandle region(int id) const { return (*this)[id].region; }
+    int dropItem(int id) const {
+        const int item = (*this)[id].dropItem;
+        return item == TileProperties::kDropSelf ? id : item;
+    }
+
+    // Atlas region name from the map config ("" when the id has none); only needed while resolving handles.
+    const std::string &regionName(int id) const {
+        static const std::string none;
+        return id >= 0 && id < static_cast<int>(names.size()) ? names[id] : none;
+    }
+    void setRegion(int id, RegionHandle handle) {
+        if (id >= 0 && id < static_cast<int>(props.size()))
+            props[id].region = handle;
+    }
+
+  private:
+    std::vector<TileProperties> props;
+    std::vector<std::string> names;
+};
+
+#endif // DDD_UTILS_TILE_REGISTRY_H
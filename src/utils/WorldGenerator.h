@@ -0,0 +1,284 @@
+#ifndef DDD_UTILS_WORLD_GENERATOR_H
+#define DDD_UTILS_WORLD_GENERATOR_H
+
+#include "utils/TileChunkStore.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Seeded terrain generator: rolling surface, dirt over stone, caves, ore veins, lakes, trees and houses.
+// Every tile is a pure function of the seed and its coordinates: noise is hashed from integer lattice points and
+// structures are anchored to fixed-width column cells, each chunk stamping only the parts that overlap it. Chunks
+// can therefore be generated in any order on any number of threads with identical output.
+class WorldGenerator {
+  public:
+    // Bump when the output for a given seed changes, so cached worlds are regenerated.
+    static constexpr int kVersion = 1;
+
+    struct Settings {
+        std::uint64_t seed{1};
+        int width{4096};
+        int height{1024};
+        float surfaceLevel{0.25f}; // mean surface row, as a fraction of the height from the top
+        float hillHeight{40.0f};   // tiles above/below the mean surface
+        float waterLevel{0.28f};   // open air below this row fraction fills with water
+        float caveDensity{0.5f};   // 0..1
+        float oreDensity{0.5f};    // 0..1
+        float treeChance{0.55f};   // per structure cell
+        float houseChance{0.12f};  // per structure cell, checked before trees
+        int threads{0};            // 0 = hardware concurrency
+    };
+
+    // Tile ids for each material; `empty` is the map's empty id.
+    struct Tiles {
+        int empty{-1};
+        int grass{-1};
+        int dirt{-1};
+        int stone{-1};
+        int ore{-1};
+        int trunk{-1};
+        int leaves{-1};
+        int water{-1};
+        int roof{-1};
+        int wall{-1};
+    };
+
+    WorldGenerator(const Settings &s, const Tiles &t)
+        : settings(s), tiles(t), meanSurface(s.surfaceLevel * static_cast<float>(s.height)),
+          waterRow(static_cast<int>(s.waterLevel * static_cast<float>(s.height))) {}
+
+    // First solid row of column x before structures (data y grows downward).
+    int surfaceRow(int x) const {
+        const float fx = static_cast<float>(x);
+        const float hills = fbm(fx * 0.004f, 0.0f, kSaltSurface, 4) - 0.5f;
+        const float bumps = value(fx * 0.05f, 0.5f, kSaltSurface + 1) - 0.5f;
+        const float row = meanSurface + hills * 2.0f * settings.hillHeight + bumps * 3.0f;
+        return std::clamp(static_cast<int>(row), 2, settings.height - 2);
+    }
+
+    // Spawn tile (first air row above the ground) near the middle of the world; kept clear of structures.
+    void spawnTile(int &x, int &y) const {
+        x = settings.width / 2;
+        y = std::max(0, surfaceRow(x) - 2);
+    }
+
+    // Fills `out` (kChunkArea ids, row-major) with chunk (cx, cy); tiles outside the world are empty.
+    void generateChunk(int cx, int cy, std::vector<int> &out) const {
+        constexpr int kSize = TileChunkStore::kChunkSize;
+        out.assign(TileChunkStore::kChunkArea, tiles.empty);
+        const int x0 = cx * kSize;
+        const int y0 = cy * kSize;
+
+        int rows[kSize];
+        int dirtDepth[kSize];
+        for (int lx = 0; lx < kSize; ++lx) {
+            rows[lx] = surfaceRow(x0 + lx);
+            dirtDepth[lx] = 3 + static_cast<int>(value(static_cast<float>(x0 + lx) * 0.08f, 1.5f, kSaltDirt) * 5.0f);
+        }
+        for (int ly = 0; ly < kSize; ++ly) {
+            const int y = y0 + ly;
+            if (y < 0 || y >= settings.height)
+                continue;
+            for (int lx = 0; lx < kSize; ++lx) {
+                const int x = x0 + lx;
+                if (x < 0 || x >= settings.width)
+                    continue;
+                out[TileChunkStore::localIndex(lx, ly)] = terrainAt(x, y, rows[lx], dirtDepth[lx]);
+            }
+        }
+        stampStructures(x0, y0, out);
+    }
+
+    // Generates the half-open chunk range into chunks[(cy - cy0) * (cx1 - cx0) + (cx - cx0)] on worker threads.
+    void generateChunks(int cx0, int cy0, int cx1, int cy1, std::vector<std::vector<int>> &chunks) const {
+        const int columns = cx1 - cx0;
+        const int count = columns * (cy1 - cy0);
+        if (count <= 0)
+            return;
+        chunks.resize(static_cast<std::size_t>(count));
+        const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        const int threadCount = std::clamp(settings.threads > 0 ? settings.threads : hardware, 1, count);
+
+        std::atomic<int> next{0};
+        const auto work = [&] {
+            for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+                generateChunk(cx0 + i % columns, cy0 + i / columns, chunks[i]);
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (int t = 1; t < threadCount; ++t)
+            workers.emplace_back(work);
+        work();
+        for (auto &w : workers)
+            w.join();
+    }
+
+  private:
+    static constexpr std::uint64_t kSaltSurface = 0x100;
+    static constexpr std::uint64_t kSaltDirt = 0x200;
+    static constexpr std::uint64_t kSaltCave = 0x300;
+    static constexpr std::uint64_t kSaltOre = 0x400;
+    static constexpr std::uint64_t kSaltStructure = 0x500;
+
+    // Structures are anchored once per cell of this many columns; kMaxReach bounds their half-width.
+    static constexpr int kCellWidth = 24;
+    static constexpr int kMaxReach = 8;
+    static constexpr int kSpawnClearance = 12;
+
+    static std::uint32_t hash(std::uint64_t seed, int x, int y) {
+        std::uint64_t h = seed ^ (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) * 0x9E3779B97F4A7C15ull) ^
+                          (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) * 0xC2B2AE3D27D4EB4Full);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return static_cast<std::uint32_t>(h);
+    }
+
+    static float unit(std::uint32_t h) { return static_cast<float>(h >> 8) * (1.0f / 16777216.0f); }
+
+    // Smoothed value noise in [0, 1).
+    float value(float x, float y, std::uint64_t salt) const {
+        const float fx = std::floor(x);
+        const float fy = std::floor(y);
+        const int ix = static_cast<int>(fx);
+        const int iy = static_cast<int>(fy);
+        const float tx = x - fx;
+        const float ty = y - fy;
+        const float sx = tx * tx * (3.0f - 2.0f * tx);
+        const float sy = ty * ty * (3.0f - 2.0f * ty);
+        const std::uint64_t seed = settings.seed + salt;
+        const float a = unit(hash(seed, ix, iy));
+        const float b = unit(hash(seed, ix + 1, iy));
+        const float c = unit(hash(seed, ix, iy + 1));
+        const float d = unit(hash(seed, ix + 1, iy + 1));
+        const float top = a + (b - a) * sx;
+        const float bottom = c + (d - c) * sx;
+        return top + (bottom - top) * sy;
+    }
+
+    float fbm(float x, float y, std::uint64_t salt, int octaves) const {
+        float sum = 0.0f;
+        float amplitude = 0.5f;
+        float norm = 0.0f;
+        for (int o = 0; o < octaves; ++o) {
+            sum += value(x, y, salt + static_cast<std::uint64_t>(o)) * amplitude;
+            norm += amplitude;
+            x *= 2.0f;
+            y *= 2.0f;
+            amplitude *= 0.5f;
+        }
+        return sum / norm;
+    }
+
+    int terrainAt(int x, int y, int surface, int dirtDepth) const {
+        if (y < surface)
+            return y >= waterRow ? tiles.water : tiles.empty;
+        if (y == settings.height - 1)
+            return tiles.stone; // bedrock
+        const int depth = y - surface;
+        const float fx = static_cast<float>(x);
+        const float fy = static_cast<float>(y);
+        if (depth > 5 && settings.caveDensity > 0.0f) {
+            // Caves open up with depth: the threshold drops over the first 64 rows below the surface.
+            const float ramp = std::min(1.0f, static_cast<float>(depth - 5) / 64.0f);
+            const float threshold = 0.72f - 0.12f * settings.caveDensity * ramp;
+            if (fbm(fx * 0.035f, fy * 0.05f, kSaltCave, 3) > threshold)
+                return tiles.empty;
+        }
+        if (depth == 0)
+            return surface >= waterRow ? tiles.dirt : tiles.grass;
+        if (depth <= dirtDepth)
+            return tiles.dirt;
+        if (tiles.ore >= 0 && settings.oreDensity > 0.0f &&
+            fbm(fx * 0.11f, fy * 0.11f, kSaltOre, 2) > 0.8f - 0.08f * settings.oreDensity)
+            return tiles.ore;
+        return tiles.stone;
+    }
+
+    // Writes into the chunk buffer when (x, y) falls inside both the chunk and the world.
+    void put(int x0, int y0, std::vector<int> &out, int x, int y, int id) const {
+        const int lx = x - x0;
+        const int ly = y - y0;
+        if (lx < 0 || ly < 0 || lx >= TileChunkStore::kChunkSize || ly >= TileChunkStore::kChunkSize)
+            return;
+        if (x < 0 || y < 0 || x >= settings.width || y >= settings.height)
+            return;
+        out[TileChunkStore::localIndex(lx, ly)] = id;
+    }
+
+    void stampStructures(int x0, int y0, std::vector<int> &out) const {
+        const int firstCell = std::max(0, (x0 - kMaxReach) / kCellWidth);
+        const int lastCell = (x0 + TileChunkStore::kChunkSize + kMaxReach) / kCellWidth;
+        for (int cell = firstCell; cell <= lastCell; ++cell) {
+            const std::uint32_t h = hash(settings.seed + kSaltStructure, cell, 0);
+            const int anchor = cell * kCellWidth + kMaxReach + static_cast<int>(h % (kCellWidth - 2 * kMaxReach));
+            if (anchor >= settings.width - kMaxReach || std::abs(anchor - settings.width / 2) < kSpawnClearance)
+                continue;
+            const int surface = surfaceRow(anchor);
+            if (surface >= waterRow)
+                continue; // no building under water
+            const float roll = unit(hash(settings.seed + kSaltStructure, cell, 1));
+            const std::uint32_t shape = hash(settings.seed + kSaltStructure, cell, 2);
+            if (roll < settings.houseChance)
+                stampHouse(x0, y0, out, anchor, surface, shape);
+            else if (roll < settings.houseChance + settings.treeChance)
+                stampTree(x0, y0, out, anchor, surface, shape);
+        }
+    }
+
+    void stampTree(int x0, int y0, std::vector<int> &out, int ax, int surface, std::uint32_t shape) const {
+        const int trunkHeight = 4 + static_cast<int>(shape % 4);
+        const int radius = 2 + static_cast<int>((shape >> 4) % 2);
+        const int crownY = surface - trunkHeight;
+        for (int dy = -radius; dy <= radius; ++dy) {
+            for (int dx = -radius; dx <= radius; ++dx) {
+                if (dx * dx + dy * dy <= radius * radius + 1)
+                    put(x0, y0, out, ax + dx, crownY + dy, tiles.leaves);
+            }
+        }
+        for (int y = surface - 1; y > crownY; --y)
+            put(x0, y0, out, ax, y, tiles.trunk);
+    }
+
+    void stampHouse(int x0, int y0, std::vector<int> &out, int ax, int surface, std::uint32_t shape) const {
+        const int halfWidth = 3 + static_cast<int>(shape % 3); // 7..11 wide
+        const int wallHeight = 4 + static_cast<int>((shape >> 3) % 2);
+        const int left = ax - halfWidth;
+        const int right = ax + halfWidth;
+        // Steep ground would leave the house floating or buried; such cells stay empty.
+        if (std::abs(surfaceRow(left) - surface) > 2 || std::abs(surfaceRow(right) - surface) > 2)
+            return;
+        const int floorY = surface;
+        const int ceilingY = floorY - wallHeight;
+        for (int x = left; x <= right; ++x) {
+            // Foundation down to the terrain, floor, then walls or interior air.
+            const int ground = surfaceRow(x);
+            for (int y = floorY + 1; y <= ground; ++y)
+                put(x0, y0, out, x, y, tiles.dirt);
+            put(x0, y0, out, x, floorY, tiles.wall);
+            const bool wall = (x == left || x == right);
+            for (int y = ceilingY + 1; y < floorY; ++y) {
+                const bool door = (x == left) && y >= floorY - 2;
+                put(x0, y0, out, x, y, wall && !door ? tiles.wall : tiles.empty);
+            }
+        }
+        // Gabled roof: each row one tile narrower on both sides.
+        for (int k = 0; k <= halfWidth + 1; ++k) {
+            for (int x = left - 1 + k; x <= right + 1 - k; ++x)
+                put(x0, y0, out, x, ceilingY - k, tiles.roof);
+        }
+    }
+
+    Settings settings;
+    Tiles tiles;
+    float meanSurface{0.0f};
+    int waterRow{0};
+};
+
+#endif // DDD_UTILS_WORLD_GENERATOR_H